@@ -0,0 +1,276 @@
+#ifndef _ASYNC_SCROLLING_CHAIN_HPP_
+#define _ASYNC_SCROLLING_CHAIN_HPP_
+
+#include "AsyncScrollingMessage.hpp"
+
+/**
+ * AsyncScrollingChain
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Owns a linked list of AsyncScrollingMessages, such as the messages returned
+ * by generateMessages, and deletes all of them, including continuations, when
+ * the chain is destroyed or cleared. A chain can lead into the messages of
+ * an AsyncScrollingPlaylist, for example to play them after its own. It
+ * ends at the first of them, which is never deleted or unlinked, since the
+ * playlist frees them itself.
+ *
+ * The matrix plays from the animation buffer, not from the message objects,
+ * so a chain can be destroyed while any message, even one of its own, is
+ * played as a sequence, with showMessage or AsyncScrollingPlayer.
+ * AsyncScrollingScroller and AsyncScrollingCompositor read the message on
+ * every frame instead, so stop them first, or wait until isScrolling returns
+ * false, before destroying a chain whose message they are scrolling. Don't
+ * use pointers into a chain after it is destroyed.
+ */
+class AsyncScrollingChain {
+public:
+
+  /**
+   * Create an empty chain
+   */
+  AsyncScrollingChain()
+    : first(nullptr) {
+  }
+
+  /**
+   * Take ownership of first and every message linked after it. The messages
+   * must have been created with new or generateMessages.
+   */
+  explicit AsyncScrollingChain(AsyncScrollingMessage* first)
+    : first(first) {
+  }
+
+  AsyncScrollingChain(const AsyncScrollingChain&) = delete;
+  AsyncScrollingChain& operator=(const AsyncScrollingChain&) = delete;
+
+  AsyncScrollingChain(AsyncScrollingChain&& other)
+    : first(other.release()) {
+  }
+
+  AsyncScrollingChain& operator=(AsyncScrollingChain&& other) {
+    if (this != &other) {
+      clear();
+      first = other.release();
+    }
+    return *this;
+  }
+
+  ~AsyncScrollingChain() {
+    clear();
+  }
+
+  /**
+   * Returns a pointer to the first message or nullptr if the chain is empty
+   */
+  AsyncScrollingMessage* getFirst() {
+    return first;
+  }
+
+  /**
+   * Returns a pointer to the last message or nullptr if the chain is empty.
+   * If the chain was made to loop back to one of its messages, this is the
+   * message that links back to it.
+   */
+  AsyncScrollingMessage* getLast() {
+    AsyncScrollingMessage* last = first;
+    for (size_t count = countLinked(); count > 1; count--) {
+      last = last->next;
+    }
+    return last;
+  }
+
+  /**
+   * Returns true if the chain has no messages
+   */
+  bool isEmpty() const {
+    return first == nullptr;
+  }
+
+  /**
+   * The number of frames of every message in the chain together, see
+   * AsyncScrollingMessage::getFrameCount. A chain that loops back to any
+   * of its messages counts each of them once, and so do the durations.
+   */
+  size_t getFrameCount() const {
+    size_t frames = 0;
+    const AsyncScrollingMessage* m = first;
+    for (size_t count = countLinked(); count > 0; count--) {
+      frames += m->getFrameCount();
+      m = m->next;
+    }
+    return frames;
+  }
+
+  /**
+   * How many milliseconds it takes to show every message in the chain once,
+   * one after the other, when they scroll one column every scrollSpeed
+   * milliseconds. See AsyncScrollingMessage::getDuration.
+   */
+  unsigned long getDuration(unsigned long scrollSpeed) const {
+    unsigned long duration = 0;
+    const AsyncScrollingMessage* m = first;
+    for (size_t count = countLinked(); count > 0; count--) {
+      duration += m->getDuration(scrollSpeed);
+      m = m->next;
+    }
+    return duration;
+  }
+
+  /**
+   * How many milliseconds it takes to play every message in the chain once
+   * as sequences, each shown from the callback of the one before it. See
+   * AsyncScrollingMessage::getSequenceDuration.
+   */
+  unsigned long getSequenceDuration(unsigned long scrollSpeed) const {
+    unsigned long duration = 0;
+    const AsyncScrollingMessage* m = first;
+    for (size_t count = countLinked(); count > 0; count--) {
+      duration += m->getSequenceDuration(scrollSpeed);
+      m = m->next;
+    }
+    return duration;
+  }
+
+  /**
+   * Move all messages of other to the end of this chain. other is left
+   * empty.
+   */
+  void append(AsyncScrollingChain&& other) {
+    if (this == &other || other.isEmpty()) {
+      return;
+    }
+    if (isEmpty()) {
+      first = other.release();
+    } else {
+      getLast()->setNext(other.release());
+    }
+  }
+
+  /**
+   * Move all messages of other into this chain after position, which has to
+   * be a message of this chain. If position has a continuation, the messages
+   * are inserted after the last continuation instead so a message is never
+   * split. other is left empty.
+   */
+  void insertAfter(AsyncScrollingMessage* position, AsyncScrollingChain&& other) {
+    if (this == &other || other.isEmpty()) {
+      return;
+    }
+    while (position->hasContinuation()) {
+      position = position->getNext();
+    }
+    AsyncScrollingMessage* otherLast = other.getLast();
+    otherLast->setNext(position->getNext());
+    position->setNext(other.release());
+  }
+
+  /**
+   * Give up ownership of the messages and return the first one. The chain is
+   * left empty and the caller is responsible for deleting the messages.
+   */
+  AsyncScrollingMessage* release() {
+    AsyncScrollingMessage* released = first;
+    first = nullptr;
+    return released;
+  }
+
+  /**
+   * Delete every message in the chain. The chain ends at the first message
+   * that belongs to an AsyncScrollingPlaylist, which is left as it is
+   * together with everything linked after it, since the playlist frees its
+   * own messages. A chain that loops back to any of its messages is
+   * deleted once around.
+   */
+  void clear() {
+    AsyncScrollingMessage* current = first;
+    for (size_t count = countOwned(); count > 0; count--) {
+      AsyncScrollingMessage* next = current->next;
+      delete current;
+      current = next;
+    }
+    first = nullptr;
+  }
+
+private:
+
+  typedef const AsyncScrollingMessage* (*After)(const AsyncScrollingMessage*);
+
+  // the message after m, or nullptr at the end
+  static const AsyncScrollingMessage* linkedAfter(
+    const AsyncScrollingMessage* m) {
+    return m->next;
+  }
+
+  // the message after m that the chain owns, or nullptr at the end or at
+  // a message of a playlist
+  static const AsyncScrollingMessage* ownedAfter(
+    const AsyncScrollingMessage* m) {
+    const AsyncScrollingMessage* next = m->next;
+    return next != nullptr && !next->pooled ? next : nullptr;
+  }
+
+  // the number of different messages reached from start by following
+  // after. a loop can lead back to any message, not just the first one, so
+  // it is found with Brent's cycle detection, which only follows the links
+  // and changes nothing. the last of them links to nullptr or back into
+  // the loop
+  static size_t countDistinct(const AsyncScrollingMessage* start, After after) {
+    if (start == nullptr) {
+      return 0;
+    }
+
+    // find the length of the loop, if there is one
+    size_t power = 1;
+    size_t loop = 1;
+    const AsyncScrollingMessage* tortoise = start;
+    const AsyncScrollingMessage* hare = after(start);
+    while (hare != nullptr && hare != tortoise) {
+      if (power == loop) {
+        tortoise = hare;
+        power *= 2;
+        loop = 0;
+      }
+      hare = after(hare);
+      loop++;
+    }
+
+    if (hare == nullptr) {
+      size_t count = 0;
+      for (const AsyncScrollingMessage* m = start; m != nullptr; m = after(m)) {
+        count++;
+      }
+      return count;
+    }
+
+    // then the number of messages before the loop starts
+    tortoise = start;
+    hare = start;
+    for (size_t i = 0; i < loop; i++) {
+      hare = after(hare);
+    }
+    size_t before = 0;
+    while (tortoise != hare) {
+      tortoise = after(tortoise);
+      hare = after(hare);
+      before++;
+    }
+    return before + loop;
+  }
+
+  // the number of different messages linked from first, once around a loop
+  size_t countLinked() const {
+    return countDistinct(first, linkedAfter);
+  }
+
+  // the number of different messages clear deletes
+  size_t countOwned() const {
+    if (first == nullptr || first->pooled) {
+      return 0;
+    }
+    return countDistinct(first, ownedAfter);
+  }
+
+  AsyncScrollingMessage* first;
+};
+
+#endif
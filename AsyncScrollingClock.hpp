@@ -0,0 +1,115 @@
+#ifndef _ASYNC_SCROLLING_CLOCK_HPP_
+#define _ASYNC_SCROLLING_CLOCK_HPP_
+
+/**
+ * AsyncScrollingClock
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * The clock every part of the library reads the time from. Normally this is
+ * just millis() and micros(), but it can be switched to a virtual clock that
+ * only moves when told to. With a virtual clock, a sketch or a simulation on
+ * a computer can fast forward through hours of scrolling in seconds, for
+ * example to check for memory leaks, since the library can't tell the
+ * difference.
+ *
+ *   AsyncScrollingClock::startVirtual();
+ *   while (...) {
+ *     AsyncScrollingClock::advance(60);
+ *     scroller.update();
+ *   }
+ *
+ * Only the library's own timing follows the virtual clock. The matrix plays
+ * sequences with its own hardware timer, so use AsyncScrollingScroller when
+ * running on a virtual clock.
+ */
+class AsyncScrollingClock {
+public:
+
+  typedef unsigned long (*Source)();
+
+  /**
+   * The current time in milliseconds
+   */
+  static unsigned long millis() {
+    State& state = getState();
+    if (state.virtualTime) {
+      return (unsigned long)(state.virtualMicros / 1000);
+    }
+    return state.millisSource != nullptr ? state.millisSource() : ::millis();
+  }
+
+  /**
+   * The current time in microseconds
+   */
+  static unsigned long micros() {
+    State& state = getState();
+    if (state.virtualTime) {
+      return (unsigned long)state.virtualMicros;
+    }
+    return state.microsSource != nullptr ? state.microsSource() : ::micros();
+  }
+
+  /**
+   * Read the time from other functions, such as the clock of a matrix
+   * emulator. Passing nullptr goes back to millis() and micros().
+   */
+  static void setSource(Source millisSource, Source microsSource) {
+    State& state = getState();
+    state.millisSource = millisSource;
+    state.microsSource = microsSource;
+  }
+
+  /**
+   * Switch to a virtual clock that starts at startMillis and only moves
+   * when advance is called
+   */
+  static void startVirtual(unsigned long startMillis = 0) {
+    State& state = getState();
+    state.virtualMicros = (uint64_t)startMillis * 1000;
+    state.virtualTime = true;
+  }
+
+  /**
+   * Move the virtual clock forward
+   */
+  static void advance(unsigned long milliseconds) {
+    advanceMicros((uint64_t)milliseconds * 1000);
+  }
+
+  /**
+   * Move the virtual clock forward in microseconds
+   */
+  static void advanceMicros(uint64_t microseconds) {
+    getState().virtualMicros += microseconds;
+  }
+
+  /**
+   * Go back to the real clock
+   */
+  static void stopVirtual() {
+    getState().virtualTime = false;
+  }
+
+  /**
+   * Returns true if the virtual clock is in use
+   */
+  static bool isVirtual() {
+    return getState().virtualTime;
+  }
+
+private:
+
+  struct State {
+    Source millisSource;
+    Source microsSource;
+    uint64_t virtualMicros;
+    bool virtualTime;
+  };
+
+  static State& getState() {
+    static State state = { nullptr, nullptr, 0, false };
+    return state;
+  }
+};
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef _ASYNC_SCROLLING_COMPACT_PLAYLIST_HPP_
+#define _ASYNC_SCROLLING_COMPACT_PLAYLIST_HPP_
+
+#include <new>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AsyncScrollingPlaylist.hpp"
+
+/**
+ * AsyncScrollingCompactPlaylist
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * A playlist for a large number of messages that does not keep a message
+ * object for every message and continuation. The items stay in the array
+ * they were given in, and the order they play in is a table of 16 bit item
+ * indexes, two bytes per item. Message objects are only created for the
+ * message that is playing and the one or two after it, and are reused over
+ * and over, so the RAM used does not grow with the length of the texts.
+ *
+ * The items array and the texts are not copied, so they have to stay valid
+ * for as long as the playlist exists. A const array of string literals never
+ * uses any RAM for the texts.
+ *
+ *   AsyncScrollingCompactPlaylist playlist(items, count, matrix, anim);
+ *   ...
+ *   current = playlist.next();
+ *   current->showMessage();
+ */
+class AsyncScrollingCompactPlaylist {
+public:
+
+  // the link of the last item, after which next returns nullptr
+  static const uint16_t END = 0xFFFF;
+
+  /**
+   * Create a playlist of count items, played in the given order. animMaxChars
+   * is the MAX_CHARS given to TEXT_ANIMATION_DEFINE, just like for
+   * AsyncScrollingMessage::generateMessages. At most END items can be used.
+   *
+   * The playlist is empty, getItemCount returns 0, if there is not enough
+   * memory for the links or if one of the items can't be planned, see
+   * AsyncScrollingPlan.
+   */
+  AsyncScrollingCompactPlaylist(
+    const AsyncScrollingPlaylistItem* items,
+    size_t count,
+    ArduinoLEDMatrix& matrix,
+    size_t animMaxChars)
+    : items(items),
+      links(nullptr),
+      matrix(&matrix),
+      animMaxChars(animMaxChars),
+      itemCount(0),
+      item(END),
+      chunk(0),
+      ahead(NONE),
+      slotItems{ END, END, END } {
+    if (count == 0 || count >= END) {
+      return;
+    }
+    for (size_t i = 0; i < count; i++) {
+      AsyncScrollingPlan plan(
+        strlen(items[i].text), items[i].font->width, matrix.width(),
+        animMaxChars);
+      if (!plan.isValid()) {
+        return;
+      }
+    }
+    links = static_cast<uint16_t*>(malloc(count * sizeof(uint16_t)));
+    if (links == nullptr) {
+      return;
+    }
+    itemCount = count;
+    for (uint16_t i = 0; i < itemCount; i++) {
+      links[i] = i + 1 < itemCount ? i + 1 : END;
+    }
+    item = 0;
+  }
+
+  /**
+   * Same as above, but the number of frames is taken from the animation
+   * buffer created with TEXT_ANIMATION_DEFINE
+   */
+  AsyncScrollingCompactPlaylist(
+    const AsyncScrollingPlaylistItem* items,
+    size_t count,
+    ArduinoLEDMatrix& matrix,
+    AsyncScrollingFrames frames)
+    : AsyncScrollingCompactPlaylist(items, count, matrix, frames.getCapacity()) {
+  }
+
+  // the messages handed out point into the playlist, so it can't be copied
+  // or moved
+  AsyncScrollingCompactPlaylist(const AsyncScrollingCompactPlaylist&) = delete;
+  AsyncScrollingCompactPlaylist& operator=(
+    const AsyncScrollingCompactPlaylist&) = delete;
+
+  ~AsyncScrollingCompactPlaylist() {
+    for (size_t slot = 0; slot < SLOTS; slot++) {
+      if (slotItems[slot] != END) {
+        getSlot(slot)->~AsyncScrollingMessage();
+      }
+    }
+    free(links);
+  }
+
+  /**
+   * Returns the next message to show, or nullptr after the last item. Its
+   * next message is already created, so AsyncScrollingPlayer can draw it
+   * ahead of time, and is what the following call returns.
+   *
+   * A message stays valid until next has been called two more times. The
+   * second of those calls creates a new message in its place, so don't keep
+   * the pointers around for longer than it takes to show them.
+   */
+  AsyncScrollingMessage* next() {
+    if (ahead == NONE) {
+      if (item == END) {
+        return nullptr;
+      }
+      ahead = 0;
+      build(ahead);
+    }
+
+    AsyncScrollingMessage* message = getSlot(ahead);
+    if (item == END) {
+      message->setNext(nullptr);
+      ahead = NONE;
+    } else {
+      uint8_t following = (ahead + 1) % SLOTS;
+      build(following);
+      message->setNext(getSlot(following));
+      ahead = following;
+    }
+    return message;
+  }
+
+  /**
+   * Start over from the first item
+   */
+  void restart() {
+    item = itemCount > 0 ? 0 : END;
+    chunk = 0;
+    ahead = NONE;
+  }
+
+  /**
+   * Play item nextItem after item, or stop after item if nextItem is END.
+   * Linking the last item to the first one makes the playlist loop. Messages
+   * that were already returned or created ahead are not changed.
+   */
+  void setNext(uint16_t item, uint16_t nextItem) {
+    if (item < itemCount && (nextItem < itemCount || nextItem == END)) {
+      links[item] = nextItem;
+    }
+  }
+
+  /**
+   * The index of the item a message returned by next belongs to, or END if
+   * it does not belong to this playlist
+   */
+  uint16_t getItemIndex(const AsyncScrollingMessage* message) const {
+    for (size_t slot = 0; slot < SLOTS; slot++) {
+      if (slotItems[slot] != END && message == getSlot(slot)) {
+        return slotItems[slot];
+      }
+    }
+    return END;
+  }
+
+  /**
+   * The number of items, or 0 if the playlist could not be created
+   */
+  size_t getItemCount() const {
+    return itemCount;
+  }
+
+private:
+
+  // the message playing, the one drawn ahead of it, and the one after that
+  static const uint8_t SLOTS = 3;
+  static const uint8_t NONE = 0xFF;
+
+  AsyncScrollingMessage* getSlot(size_t slot) const {
+    return reinterpret_cast<AsyncScrollingMessage*>(
+      const_cast<unsigned char*>(storage[slot]));
+  }
+
+  // create the message for the current chunk in the given slot and move on
+  // to the next chunk
+  void build(uint8_t slot) {
+    const AsyncScrollingPlaylistItem& current = items[item];
+    AsyncScrollingMessage::Source source(current.text, false);
+    AsyncScrollingPlan plan(
+      source.length, current.font->width, matrix->width(), animMaxChars);
+    AsyncScrollingPlan::Chunk part = plan.getChunk(chunk);
+
+    if (slotItems[slot] != END) {
+      getSlot(slot)->~AsyncScrollingMessage();
+    }
+    AsyncScrollingMessage* message = new (storage[slot]) AsyncScrollingMessage(
+      source, part.start, part.end, part.offset, part.frames, *matrix,
+      *current.font, part.hasContinuation, part.isContinuation);
+    message->pooled = true;
+    slotItems[slot] = item;
+
+    if (part.hasContinuation) {
+      chunk++;
+    } else {
+      chunk = 0;
+      item = links[item];
+    }
+  }
+
+  const AsyncScrollingPlaylistItem* items;
+  uint16_t* links;
+  ArduinoLEDMatrix* matrix;
+  size_t animMaxChars;
+  uint16_t itemCount;
+
+  // the item and chunk the next message is created from
+  uint16_t item;
+  uint16_t chunk;
+
+  // the slot of the message the next call to next returns
+  uint8_t ahead;
+  uint16_t slotItems[SLOTS];
+  alignas(AsyncScrollingMessage)
+    unsigned char storage[SLOTS][sizeof(AsyncScrollingMessage)];
+};
+
+#endif
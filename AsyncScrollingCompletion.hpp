@@ -0,0 +1,149 @@
+#ifndef _ASYNC_SCROLLING_COMPLETION_HPP_
+#define _ASYNC_SCROLLING_COMPLETION_HPP_
+
+#include <atomic>
+#include <stdint.h>
+
+#include "AsyncScrollingClock.hpp"
+
+/**
+ * AsyncScrollingCompletion
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Counts the messages that are done, for passing the matrix callback on to
+ * loop. The matrix calls its callback from an interrupt, so a plain bool set
+ * there can be read half way through being changed, and if two messages end
+ * before loop looks at it, one of them is lost. This counts every time the
+ * callback is called instead, and loop handles the count at its own pace.
+ *
+ *   AsyncScrollingCompletion done;
+ *
+ *   void matrixCallback() {
+ *     done.signal();
+ *   }
+ *
+ *   void setup() {
+ *     ...
+ *     done.kick(); // show the first message right away
+ *   }
+ *
+ *   void loop() {
+ *     if (done.poll()) {
+ *       // show the next message
+ *     }
+ *   }
+ *
+ * To know when one particular message is done, take a ticket with start
+ * right before showing it and check it with isDone or wait. Call start for
+ * every message whose end calls signal, so the tickets match the count. To
+ * get loop going without a message having ended, call kick instead of
+ * signal, which would count a message that was never shown and make every
+ * ticket look done one message early.
+ */
+class AsyncScrollingCompletion {
+public:
+
+  typedef uint32_t Ticket;
+
+  AsyncScrollingCompletion()
+    : completed(0),
+      started(0),
+      handled(0) {
+  }
+
+  AsyncScrollingCompletion(const AsyncScrollingCompletion&) = delete;
+  AsyncScrollingCompletion& operator=(const AsyncScrollingCompletion&) = delete;
+
+  /**
+   * Count one message as done. Safe to call from an interrupt, such as the
+   * matrix callback.
+   */
+  void signal() {
+    completed.fetch_add(1, std::memory_order_release);
+  }
+
+  /**
+   * Returns true once for every time signal was called, so no message is
+   * missed even if several ended since the last call
+   */
+  bool poll() {
+    if (handled == completed.load(std::memory_order_acquire)) {
+      return false;
+    }
+    handled++;
+    return true;
+  }
+
+  /**
+   * Make poll return true once more without counting a message as done,
+   * for example in setup so loop shows the first message. Tickets are not
+   * changed. Call from loop or setup, not from an interrupt.
+   */
+  void kick() {
+    handled--;
+  }
+
+  /**
+   * The number of times poll will return true before signal is called
+   * again, for every signal and kick it has not returned yet
+   */
+  uint32_t getPending() const {
+    return completed.load(std::memory_order_acquire) - handled;
+  }
+
+  /**
+   * Call right before showing a message. The returned ticket is done once
+   * that message is done.
+   */
+  Ticket start() {
+    return ++started;
+  }
+
+  /**
+   * Returns true if the message the ticket was taken for is done. A ticket
+   * of 0 is always done, so it can be used before anything was shown.
+   */
+  bool isDone(Ticket ticket) const {
+    return (int32_t)(completed.load(std::memory_order_acquire) - ticket) >= 0;
+  }
+
+  /**
+   * Returns true if every message a ticket was taken for is done
+   */
+  bool isIdle() const {
+    return isDone(started);
+  }
+
+  /**
+   * Wait until the message the ticket was taken for is done, but no longer
+   * than timeout milliseconds. Returns true if it is done. The time comes
+   * from AsyncScrollingClock, so this only waits for virtual time to pass
+   * if something else moves the virtual clock.
+   */
+  bool wait(Ticket ticket, unsigned long timeout) {
+    unsigned long since = AsyncScrollingClock::millis();
+    while (!isDone(ticket)) {
+      if (AsyncScrollingClock::millis() - since >= timeout) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * The number of times signal was called in total
+   */
+  uint32_t getCount() const {
+    return completed.load(std::memory_order_acquire);
+  }
+
+private:
+
+  // only completed is changed from the interrupt. started and handled
+  // belong to loop
+  std::atomic<uint32_t> completed;
+  Ticket started;
+  uint32_t handled;
+};
+
+#endif
@@ -0,0 +1,327 @@
+#ifndef _ASYNC_SCROLLING_COMPOSITOR_HPP_
+#define _ASYNC_SCROLLING_COMPOSITOR_HPP_
+
+#include "AsyncScrollingConfig.hpp"
+
+#include <string.h>
+
+#include "AsyncScrollingMessage.hpp"
+#include "AsyncScrollingPacer.hpp"
+
+/**
+ * AsyncScrollingCompositor
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Splits the matrix into rectangular regions that each show their own
+ * content, for example an icon or a clock that stays still on the left and a
+ * message that scrolls on the rest of the screen. A region either holds a
+ * still picture, set with setFrame or setText, or scrolls messages like
+ * AsyncScrollingScroller, on its own schedule.
+ *
+ * Text is drawn with its top on the top row of its region, and rows of it
+ * that don't fit in the region are cut off. Text on the whole screen starts
+ * on the second row, so a region from the second row down shows it in the
+ * same place.
+ *
+ * Every region keeps its own frame, which only changes when its content
+ * does. When any of them changed, the screen is put together by masking each
+ * region's frame to its rectangle, and loaded into the matrix once.
+ *
+ *   AsyncScrollingCompositor screen(matrix, 60);
+ *   uint8_t icon = screen.addRegion(0, 0, 3, 8);
+ *   uint8_t text = screen.addRegion(3, 1, 9, 7);
+ *   screen.setFrame(icon, heart);
+ *   screen.show(text, message);
+ *   ...
+ *   void loop() {
+ *     screen.update();
+ *   }
+ *
+ * Don't play a sequence on the matrix, for example with showMessage, while
+ * the compositor is in use.
+ */
+class AsyncScrollingCompositor {
+public:
+
+  // returned by addRegion when no region could be added
+  static const uint8_t NO_REGION = 0xFF;
+
+  /**
+   * Create a compositor without any regions. Messages scroll one column every
+   * scrollSpeed milliseconds, like matrix.textScrollSpeed.
+   */
+  AsyncScrollingCompositor(ArduinoLEDMatrix& matrix, unsigned long scrollSpeed)
+    : matrix(&matrix),
+      scrollSpeed(scrollSpeed),
+      regionCount(0),
+      dirty(false) {
+    AsyncScrollingRender::clear(screen);
+  }
+
+  /**
+   * Add a region width columns wide and height rows high, with its top left
+   * corner at column x and row y. Returns the index of the region, or
+   * NO_REGION if the rectangle is not on the screen or there are already
+   * ASYNC_SCROLLING_MESSAGE_REGIONS regions. Regions should not overlap,
+   * where they do the pixels of both are shown.
+   */
+  uint8_t addRegion(uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+    if (regionCount >= ASYNC_SCROLLING_MESSAGE_REGIONS || width == 0
+      || height == 0 || x + width > AsyncScrollingRender::SCREEN_WIDTH
+      || y + height > AsyncScrollingRender::SCREEN_HEIGHT) {
+      return NO_REGION;
+    }
+
+    Region& region = regions[regionCount];
+    region.x = x;
+    region.y = y;
+    region.width = width;
+    region.height = height;
+    region.message = nullptr;
+    region.callback = nullptr;
+    region.frameIndex = 0;
+    region.frameCount = 0;
+    AsyncScrollingRender::clear(region.frame);
+
+    // the mask has the pixels of the rectangle on, so a region's frame can
+    // be merged into the screen with a few bitwise operations
+    AsyncScrollingRender::clear(region.mask);
+    for (uint8_t i = 0; i < width; i++) {
+      AsyncScrollingRender::setColumn(region.mask, x + i, getRows(region));
+    }
+    return regionCount++;
+  }
+
+  /**
+   * Set a function that is called when the message scrolling in the region is
+   * done. If update is called from an interrupt, so is the callback.
+   */
+  void setCallback(uint8_t index, voidFuncPtr callback) {
+    if (index < regionCount) {
+      regions[index].callback = callback;
+    }
+  }
+
+  /**
+   * Set how many milliseconds each column is shown in every region, like
+   * matrix.textScrollSpeed
+   */
+  void setScrollSpeed(unsigned long scrollSpeed) {
+    this->scrollSpeed = scrollSpeed;
+  }
+
+  /**
+   * Show a still picture in the region. frame is a whole screen in the format
+   * of matrix.loadFrame, only the part inside the region is shown. A message
+   * that was scrolling in the region is stopped without calling the
+   * callback.
+   */
+  void setFrame(uint8_t index, const uint32_t frame[3]) {
+    if (index >= regionCount) {
+      return;
+    }
+    Region& region = regions[index];
+    region.message = nullptr;
+    for (size_t i = 0; i < 3; i++) {
+      region.frame[i] = frame[i];
+    }
+    dirty = true;
+  }
+
+  /**
+   * Show text that does not move in the region, starting at its left edge.
+   * Text that doesn't fit is cut off. A message that was scrolling in the
+   * region is stopped without calling the callback.
+   */
+  void setText(uint8_t index, const char* text, const Font& font) {
+    if (index >= regionCount) {
+      return;
+    }
+    Region& region = regions[index];
+    region.message = nullptr;
+    AsyncScrollingRender::clear(region.frame);
+    size_t length = strlen(text);
+    for (size_t x = 0; x < region.width && x / font.width < length; x++) {
+      uint8_t pixels = AsyncScrollingRender::glyphColumn(
+        font, text[x / font.width], x % font.width);
+      AsyncScrollingRender::setColumn(
+        region.frame, region.x + x, place(region, pixels));
+    }
+    dirty = true;
+  }
+
+  /**
+   * Start scrolling message in the region. Like on the whole screen, the
+   * text starts at the left edge of the region and scrolls until its last
+   * column has left it. A message that fits in the region is shown centered
+   * without scrolling for its static duration.
+   */
+  void show(uint8_t index, AsyncScrollingMessage* message) {
+    if (index >= regionCount || message == nullptr) {
+      return;
+    }
+    ASYNC_SCROLLING_CPU(FRAME);
+    Region& region = regions[index];
+    region.message = message;
+    region.frameIndex = 0;
+    AsyncScrollingRender::clear(region.frame);
+
+    if (isStatic(region)) {
+      int x = region.x + ((int)region.width - (int)message->getWidth()) / 2;
+      for (size_t column = 0; column < message->getWidth(); column++) {
+        AsyncScrollingRender::setColumn(region.frame, x + column,
+          place(region, message->getColumnPixels(column)));
+      }
+      region.frameCount = 1;
+      region.pacer.resume(message->getStaticDuration());
+    } else {
+      for (size_t x = 0; x < region.width; x++) {
+        AsyncScrollingRender::setColumn(region.frame, region.x + x,
+          place(region,
+            message->getColumnPixels(message->getColumnOffset() + x)));
+      }
+      // a continuation stops where the next one starts, anything else
+      // scrolls until its last column leaves the region
+      region.frameCount = message->isContinuation()
+        || message->hasContinuation()
+        ? message->getFrameCount() : message->getWidth();
+      region.pacer.resume(scrollSpeed);
+    }
+    dirty = true;
+    ASYNC_SCROLLING_TRACE(PLAY, index);
+  }
+
+  /**
+   * Returns true while a message is scrolling in the region
+   */
+  bool isScrolling(uint8_t index) const {
+    return index < regionCount && regions[index].message != nullptr;
+  }
+
+  /**
+   * Stop the message scrolling in the region without calling the callback.
+   * What the region shows stays. The compositor reads the message on every
+   * frame, so call this before deleting a message that is scrolling, or the
+   * chain it is in.
+   */
+  void stop(uint8_t index) {
+    if (index < regionCount) {
+      regions[index].message = nullptr;
+      regions[index].pacer.stop();
+    }
+  }
+
+  /**
+   * Call this from loop as often as possible. It moves the messages that are
+   * due to move, and loads the screen into the matrix if any region changed.
+   */
+  void update() {
+    ASYNC_SCROLLING_CPU(FRAME);
+    for (uint8_t i = 0; i < regionCount; i++) {
+      if (regions[i].message != nullptr && regions[i].pacer.isDue()) {
+        tick(i);
+      }
+    }
+    if (dirty) {
+      compose();
+      matrix->loadFrame(screen);
+    }
+  }
+
+  /**
+   * The screen as it was last loaded into the matrix
+   */
+  const uint32_t* getFrame() const {
+    return screen;
+  }
+
+  /**
+   * The pacer that schedules the frames of the region, to see the frames per
+   * second that were achieved and how late frames were shown
+   */
+  const AsyncScrollingPacer& getPacer(uint8_t index) const {
+    return regions[index].pacer;
+  }
+
+private:
+
+  struct Region {
+    uint32_t mask[3];
+    uint32_t frame[3];
+    AsyncScrollingMessage* message;
+    voidFuncPtr callback;
+    size_t frameIndex;
+    size_t frameCount;
+    AsyncScrollingPacer pacer;
+    uint8_t x;
+    uint8_t y;
+    uint8_t width;
+    uint8_t height;
+  };
+
+  // the rows of a column that are inside the region
+  static uint8_t getRows(const Region& region) {
+    return ((1 << region.height) - 1) << region.y;
+  }
+
+  // move a column of text, which has its top on TEXT_TOP like on the whole
+  // screen, so its top is on the top row of the region, and cut off the
+  // rows below the region
+  static uint8_t place(const Region& region, uint8_t pixels) {
+    int shift = (int)region.y - (int)AsyncScrollingRender::TEXT_TOP;
+    uint8_t moved = shift >= 0 ? pixels << shift : pixels >> -shift;
+    return moved & getRows(region);
+  }
+
+  static bool isStatic(const Region& region) {
+    const AsyncScrollingMessage* message = region.message;
+    return !message->hasContinuation() && !message->isContinuation()
+      && message->getWidth() <= region.width;
+  }
+
+  // move the text in the region one column to the left, or finish the
+  // message if the last frame was showing
+  void tick(uint8_t index) {
+    Region& region = regions[index];
+    region.frameIndex++;
+    if (region.frameIndex >= region.frameCount) {
+      ASYNC_SCROLLING_TRACE(COMPLETE, index);
+      region.message = nullptr;
+      if (region.callback != nullptr) {
+        ASYNC_SCROLLING_CPU(CALLBACK);
+        region.callback();
+      }
+      return;
+    }
+
+    // the shift also moves pixels outside the region, which the mask hides,
+    // so only the rightmost column of the region has to be drawn
+    AsyncScrollingRender::shiftLeft(region.frame);
+    size_t last = region.width - 1;
+    size_t column = region.message->getColumnOffset() + region.frameIndex + last;
+    AsyncScrollingRender::setColumn(region.frame, region.x + last,
+      place(region, region.message->getColumnPixels(column)));
+    region.pacer.next(scrollSpeed);
+    dirty = true;
+    ASYNC_SCROLLING_TRACE(FRAME, region.frameIndex);
+  }
+
+  void compose() {
+    AsyncScrollingRender::clear(screen);
+    for (uint8_t r = 0; r < regionCount; r++) {
+      for (size_t i = 0; i < 3; i++) {
+        screen[i] |= regions[r].frame[i] & regions[r].mask[i];
+      }
+    }
+    dirty = false;
+  }
+
+  ArduinoLEDMatrix* matrix;
+  unsigned long scrollSpeed;
+  Region regions[ASYNC_SCROLLING_MESSAGE_REGIONS];
+  uint8_t regionCount;
+  bool dirty;
+  uint32_t screen[3];
+};
+
+#endif
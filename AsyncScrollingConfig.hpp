@@ -0,0 +1,54 @@
+#ifndef _ASYNC_SCROLLING_CONFIG_HPP_
+#define _ASYNC_SCROLLING_CONFIG_HPP_
+
+/**
+ * AsyncScrollingConfig
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * The settings of the library and their defaults, in one place. Every file
+ * of the library that reads a setting includes this first, so the defaults
+ * never depend on which file a sketch happens to include first. A setting
+ * is changed by defining it before the first include of the library, the
+ * same way in every file of the sketch that includes it:
+ *   #define ASYNC_SCROLLING_MESSAGE_STATIC_DURATION 3000
+ *   #include <AsyncScrollingMessage.hpp>
+ *
+ * ASYNC_SCROLLING_MESSAGE_TRACE, ASYNC_SCROLLING_MESSAGE_CPU and
+ * ASYNC_SCROLLING_MESSAGE_STATS also turn their feature on, so the library
+ * never defines them itself. Their sizes are read through the
+ * ASYNC_SCROLLING_*_EVENTS and ASYNC_SCROLLING_*_WINDOW names below.
+ */
+
+// the number of rows at the start of a TEXT_ANIMATION_DEFINE buffer that
+// the matrix library keeps for itself instead of frames
+#ifndef ASYNC_SCROLLING_MESSAGE_RESERVED_FRAMES
+#define ASYNC_SCROLLING_MESSAGE_RESERVED_FRAMES 1
+#endif
+
+// how long a message that fits on the screen is shown, in milliseconds,
+// unless changed with setStaticDuration
+#ifndef ASYNC_SCROLLING_MESSAGE_STATIC_DURATION
+#define ASYNC_SCROLLING_MESSAGE_STATIC_DURATION 2000
+#endif
+
+// the most regions one compositor can have
+#ifndef ASYNC_SCROLLING_MESSAGE_REGIONS
+#define ASYNC_SCROLLING_MESSAGE_REGIONS 4
+#endif
+
+// the number of events the trace keeps. when it is full the oldest events
+// are overwritten
+#ifdef ASYNC_SCROLLING_MESSAGE_TRACE
+#define ASYNC_SCROLLING_TRACE_EVENTS ASYNC_SCROLLING_MESSAGE_TRACE
+#else
+#define ASYNC_SCROLLING_TRACE_EVENTS 64
+#endif
+
+// the length in milliseconds of the window the CPU use is measured over
+#ifdef ASYNC_SCROLLING_MESSAGE_CPU
+#define ASYNC_SCROLLING_CPU_WINDOW ASYNC_SCROLLING_MESSAGE_CPU
+#else
+#define ASYNC_SCROLLING_CPU_WINDOW 1000
+#endif
+
+#endif
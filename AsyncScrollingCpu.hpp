@@ -0,0 +1,223 @@
+#ifndef _ASYNC_SCROLLING_CPU_HPP_
+#define _ASYNC_SCROLLING_CPU_HPP_
+
+#include "AsyncScrollingConfig.hpp"
+
+#include "AsyncScrollingClock.hpp"
+
+/**
+ * AsyncScrollingCpu
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Measures how much of the CPU the library uses, to make sure enough is left
+ * for the rest of the sketch. The library only measures when
+ * ASYNC_SCROLLING_MESSAGE_CPU is defined before including
+ * AsyncScrollingMessage.hpp, which also sets the length of the window in
+ * milliseconds:
+ *   #define ASYNC_SCROLLING_MESSAGE_CPU 1000
+ *   #include <AsyncScrollingMessage.hpp>
+ *
+ * The time is split into drawing frames, moving frames in the scrollers and
+ * running callbacks. The matrix calls its callback itself, so add
+ *   ASYNC_SCROLLING_CPU(CALLBACK);
+ * as the first line of the matrix callback to count it too. When one measured
+ * part runs inside another, for example a callback called by a scroller, the
+ * time is only counted for the inner part.
+ *
+ * Measuring from an interrupt, such as the matrix callback, is safe:
+ * interrupts are turned off while the measurements are updated, for a few
+ * microseconds, so an interrupt can't run in the middle of an update. The
+ * Uno R4 does not turn interrupts off while it handles one, so they are
+ * turned back on afterwards there too. Don't measure from code that has
+ * turned interrupts off itself.
+ *
+ * The time comes from AsyncScrollingClock, so on a computer the clock source
+ * can be set to a model of how fast the board is.
+ */
+class AsyncScrollingCpu {
+public:
+
+  enum Category : uint8_t {
+    // drawing the frames of a message into an animation buffer
+    RENDER = 0,
+    // moving and loading frames in the scrollers
+    FRAME = 1,
+    // the callbacks the library calls, and the matrix callback if counted
+    CALLBACK = 2
+  };
+
+  static const uint8_t CATEGORIES = 3;
+
+  /**
+   * Counts the time from when it is created until it goes out of scope, or
+   * until a Scope inside it is created
+   */
+  class Scope {
+  public:
+
+    explicit Scope(Category category)
+      : category(category) {
+      Lock lock;
+      parent = active();
+      unsigned long now = AsyncScrollingClock::micros();
+      if (parent != nullptr) {
+        parent->charge(now);
+      }
+      since = now;
+      active() = this;
+    }
+
+    ~Scope() {
+      Lock lock;
+      unsigned long now = AsyncScrollingClock::micros();
+      charge(now);
+      active() = parent;
+      if (parent != nullptr) {
+        parent->since = now;
+      }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+
+    void charge(unsigned long now) {
+      addLocked(category, now - since);
+      since = now;
+    }
+
+    Category category;
+    Scope* parent;
+    unsigned long since;
+  };
+
+  /**
+   * Count microseconds of work in a category that was measured some other
+   * way
+   */
+  static void add(Category category, unsigned long microseconds) {
+    Lock lock;
+    addLocked(category, microseconds);
+  }
+
+  /**
+   * The percentage of the CPU the category used during the window
+   */
+  static float getPercent(Category category) {
+    Lock lock;
+    Window& window = getWindow();
+    uint32_t current = advance(window);
+    unsigned long busy = 0;
+    for (size_t i = 0; i < BUCKETS; i++) {
+      busy += window.buckets[i].busy[category];
+    }
+    return busy * 100.0f / elapsed(window, current);
+  }
+
+  /**
+   * The percentage of the CPU the library used during the window
+   */
+  static float getPercent() {
+    float percent = 0;
+    for (uint8_t category = 0; category < CATEGORIES; category++) {
+      percent += getPercent((Category)category);
+    }
+    return percent;
+  }
+
+  /**
+   * Forget everything that was measured
+   */
+  static void reset() {
+    Lock lock;
+    Window& window = getWindow();
+    for (size_t i = 0; i < BUCKETS; i++) {
+      clear(window.buckets[i]);
+    }
+    window.start = AsyncScrollingClock::micros();
+    window.current = 0;
+  }
+
+private:
+
+  // the window is split into buckets that are cleared as they get too old,
+  // so the window slides along without keeping every measurement
+  static const size_t BUCKETS = 10;
+  static const unsigned long BUCKET_MICROS =
+    (unsigned long)ASYNC_SCROLLING_CPU_WINDOW * 1000 / BUCKETS;
+
+  // keeps interrupts off while it exists
+  class Lock {
+  public:
+
+    Lock() {
+      noInterrupts();
+    }
+
+    ~Lock() {
+      interrupts();
+    }
+
+    Lock(const Lock&) = delete;
+    Lock& operator=(const Lock&) = delete;
+  };
+
+  struct Bucket {
+    unsigned long busy[CATEGORIES];
+  };
+
+  struct Window {
+    Bucket buckets[BUCKETS];
+    unsigned long start;
+    uint32_t current;
+  };
+
+  static Window& getWindow() {
+    static Window window = {};
+    return window;
+  }
+
+  static Scope*& active() {
+    static Scope* scope = nullptr;
+    return scope;
+  }
+
+  static void addLocked(Category category, unsigned long microseconds) {
+    Window& window = getWindow();
+    Bucket& bucket = window.buckets[advance(window) % BUCKETS];
+    bucket.busy[category] += microseconds;
+  }
+
+  static void clear(Bucket& bucket) {
+    for (uint8_t category = 0; category < CATEGORIES; category++) {
+      bucket.busy[category] = 0;
+    }
+  }
+
+  // move the window up to now, clearing the buckets it moves past, and
+  // return the number of the bucket now is in
+  static uint32_t advance(Window& window) {
+    uint32_t now = (AsyncScrollingClock::micros() - window.start)
+      / BUCKET_MICROS;
+    uint32_t passed = now - window.current;
+    for (uint32_t i = 1; i <= passed && i <= BUCKETS; i++) {
+      clear(window.buckets[(window.current + i) % BUCKETS]);
+    }
+    window.current = now;
+    return now;
+  }
+
+  // the microseconds the window covers so far, less than the full window
+  // until enough time has passed
+  static float elapsed(const Window& window, uint32_t current) {
+    unsigned long sinceStart = AsyncScrollingClock::micros() - window.start;
+    unsigned long full = BUCKET_MICROS * BUCKETS;
+    unsigned long inBucket = sinceStart - current * BUCKET_MICROS;
+    unsigned long covered = current >= BUCKETS - 1
+      ? (BUCKETS - 1) * BUCKET_MICROS + inBucket : sinceStart;
+    return covered > 0 && covered <= full ? covered : full;
+  }
+};
+
+#endif
@@ -1,6 +1,90 @@
 #ifndef _ASYNC_SCROLLING_MESSAGE_HPP_
 #define _ASYNC_SCROLLING_MESSAGE_HPP_
 
+#include "AsyncScrollingConfig.hpp"
+
+#include <new>
+#include <utility>
+
+#include "AsyncScrollingClock.hpp"
+#include "AsyncScrollingPlan.hpp"
+#include "AsyncScrollingRender.hpp"
+#include "AsyncScrollingStats.hpp"
+
+// record an event in AsyncScrollingTrace, only if tracing is turned on by
+// defining ASYNC_SCROLLING_MESSAGE_TRACE before including this file
+#ifdef ASYNC_SCROLLING_MESSAGE_TRACE
+#include "AsyncScrollingTrace.hpp"
+#define ASYNC_SCROLLING_TRACE(event, arg) \
+  AsyncScrollingTrace::record(AsyncScrollingTrace::event, (uint16_t)(arg))
+#else
+#define ASYNC_SCROLLING_TRACE(event, arg)
+#endif
+
+// count the time until the end of the enclosing block in AsyncScrollingCpu,
+// only if measuring is turned on by defining ASYNC_SCROLLING_MESSAGE_CPU
+// before including this file
+#ifdef ASYNC_SCROLLING_MESSAGE_CPU
+#include "AsyncScrollingCpu.hpp"
+#define ASYNC_SCROLLING_CPU(category) \
+  AsyncScrollingCpu::Scope asyncScrollingCpuScope(AsyncScrollingCpu::category)
+#else
+#define ASYNC_SCROLLING_CPU(category)
+#endif
+
+// fail to compile if the string literal text, shown with a font that is
+// fontWidth columns wide, does not fit in the animation buffer frames
+// without being split into continuations. for example:
+//   ASYNC_SCROLLING_MESSAGE_ASSERT_FITS(anim, "   Hello", 5);
+#define ASYNC_SCROLLING_MESSAGE_ASSERT_FITS(frames, text, fontWidth) \
+  static_assert( \
+    AsyncScrollingMessage::fits(frames, text, fontWidth), \
+    "message does not fit in the animation buffer")
+
+// the buffer used by showMessage when no buffer is given. declaring it here
+// means this file can be included before or after TEXT_ANIMATION_DEFINE,
+// which creates it. it only has to exist if showMessage() is called
+extern uint32_t anim[][4];
+
+/**
+ * AsyncScrollingFrames
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Refers to an animation buffer created with TEXT_ANIMATION_DEFINE and
+ * remembers how many frames it holds. It is small and meant to be passed by
+ * value, the buffer itself is not copied.
+ *   TEXT_ANIMATION_DEFINE(shortAnim, 40)
+ *   AsyncScrollingFrames shortFrames(shortAnim);
+ */
+class AsyncScrollingFrames {
+public:
+
+  template <size_t N>
+  AsyncScrollingFrames(uint32_t (&frames)[N][4])
+    : frames(frames),
+      capacity(N - ASYNC_SCROLLING_MESSAGE_RESERVED_FRAMES) {
+  }
+
+  /**
+   * The buffer, in the form the matrix functions expect
+   */
+  uint32_t (*get() const)[4] {
+    return frames;
+  }
+
+  /**
+   * The number of frames the buffer can hold
+   */
+  size_t getCapacity() const {
+    return capacity;
+  }
+
+private:
+
+  uint32_t (*frames)[4];
+  size_t capacity;
+};
+
 /**
  * AsyncScrollingMessage
  * Copyright (c) 2025 Daniel Savaria
@@ -15,27 +99,159 @@
  * adds additional functionality such as looping text and creating messages
  * that are longer than the normal limit.
  */
-class AsyncScrollingMessage {
+class AsyncScrollingMessage : private AsyncScrollingStats::Counted {
 public:
 
+  /**
+   * Text that messages refer to instead of holding a copy, made with borrow
+   */
+  struct BorrowedText {
+    const char* text;
+  };
+
+  /**
+   * Mark text that messages should refer to in place instead of copying it.
+   * The text has to stay valid, and unchanged, for as long as the messages
+   * exist, which is always true for string literals and const arrays:
+   *   new AsyncScrollingMessage(
+   *     AsyncScrollingMessage::borrow("   Hello"), matrix, Font_5x7);
+   */
+  static BorrowedText borrow(const char* text) {
+    BorrowedText borrowed = { text };
+    return borrowed;
+  }
+
   AsyncScrollingMessage(
     const String& message,
     ArduinoLEDMatrix& matrix,
     const Font& font)
     : message(message),
-      matrix(matrix),
-      font(font),
+      text(nullptr),
+      length(message.length()),
+      matrix(&matrix),
+      font(&font),
+      next(nullptr),
+      offset(0),
+      flash(false),
       hContinuation(false),
       iContinuation(false),
-      next(nullptr) {
+      pooled(false),
+      frames(0),
+      staticDuration(ASYNC_SCROLLING_MESSAGE_STATIC_DURATION) {
+  }
+
+  /**
+   * Create a message that shows a copy of the given text, so the text can be
+   * changed or freed afterwards, like a char array on the stack. To show
+   * text without copying it, see borrow, or use F() for text in flash.
+   */
+  AsyncScrollingMessage(
+    const char* message,
+    ArduinoLEDMatrix& matrix,
+    const Font& font)
+    : AsyncScrollingMessage(String(message), matrix, font) {
+  }
+
+  /**
+   * Create a message that shows the text marked with borrow without copying
+   * it
+   */
+  AsyncScrollingMessage(
+    BorrowedText message,
+    ArduinoLEDMatrix& matrix,
+    const Font& font)
+    : AsyncScrollingMessage(
+      Source(message.text, false), 0, strlen(message.text), 0, 0, matrix, font,
+      false, false) {
   }
 
-  // removing copy and delete functionality to avoid bugs.
-  // could be implemented in the future.
+  /**
+   * Create a message from text stored in flash, such as F("Hello") or a
+   * PROGMEM string cast with FPSTR. The text is read directly from flash
+   * every time the message is shown and is never copied into RAM.
+   */
+  AsyncScrollingMessage(
+    const __FlashStringHelper* message,
+    ArduinoLEDMatrix& matrix,
+    const Font& font)
+    : AsyncScrollingMessage(
+      Source(message), 0, Source(message).length, 0, 0, matrix, font,
+      false, false) {
+  }
+
+  /**
+   * Create a message that takes over the buffer of a temporary String, such
+   * as the result of a function that builds the text, instead of copying it.
+   */
+  AsyncScrollingMessage(
+    String&& message,
+    ArduinoLEDMatrix& matrix,
+    const Font& font)
+    : message(std::move(message)),
+      text(nullptr),
+      length(this->message.length()),
+      matrix(&matrix),
+      font(&font),
+      next(nullptr),
+      offset(0),
+      flash(false),
+      hContinuation(false),
+      iContinuation(false),
+      pooled(false),
+      frames(0),
+      staticDuration(ASYNC_SCROLLING_MESSAGE_STATIC_DURATION) {
+  }
+
+  // copying is not allowed because two messages sharing the same next
+  // message would make it unclear which one should link to it.
   AsyncScrollingMessage(const AsyncScrollingMessage&) = delete;
-  AsyncScrollingMessage(AsyncScrollingMessage&&) = delete;
   AsyncScrollingMessage& operator=(const AsyncScrollingMessage&) = delete;
-  AsyncScrollingMessage& operator=(AsyncScrollingMessage&&) = delete;
+
+  /**
+   * Move the text, continuation flags and next message of other into this
+   * message. other is left empty with no next message. Any message whose next
+   * was other still points at other, so use setNext to point it at this
+   * message instead.
+   */
+  AsyncScrollingMessage(AsyncScrollingMessage&& other)
+    : message(std::move(other.message)),
+      text(other.text),
+      length(other.length),
+      matrix(other.matrix),
+      font(other.font),
+      next(other.next),
+      offset(other.offset),
+      flash(other.flash),
+      hContinuation(other.hContinuation),
+      iContinuation(other.iContinuation),
+      pooled(false),
+      frames(other.frames),
+      staticDuration(other.staticDuration) {
+    other.clear();
+  }
+
+  /**
+   * Same as the move constructor. The current next message of this message
+   * is not deleted, only unlinked.
+   */
+  AsyncScrollingMessage& operator=(AsyncScrollingMessage&& other) {
+    if (this != &other) {
+      message = std::move(other.message);
+      text = other.text;
+      length = other.length;
+      offset = other.offset;
+      frames = other.frames;
+      flash = other.flash;
+      matrix = other.matrix;
+      font = other.font;
+      hContinuation = other.hContinuation;
+      iContinuation = other.iContinuation;
+      staticDuration = other.staticDuration;
+      next = other.next;
+      other.clear();
+    }
+    return *this;
+  }
 
   ~AsyncScrollingMessage() {
     // not going to delete next memory
@@ -43,7 +259,15 @@ public:
   }
 
   /**
-   * Show the message on the LED Matrix.
+   * Show the message on the LED Matrix using the animation buffer named
+   * anim, created with TEXT_ANIMATION_DEFINE(anim, MAX_CHARS).
+   *
+   * A message that fits on the screen is not scrolled. It is shown as a
+   * single still frame for getStaticDuration milliseconds, and then the
+   * matrix callback is called just like when a scrolling message is done.
+   * The frame is listed twice in the buffer for that. A buffer with room for
+   * only one frame shows it and calls the callback right away, and one with
+   * no room shows nothing.
    * 
    * Before calling this. the matrix should be set up.
    * See the included example files for more detail.
@@ -53,19 +277,170 @@ public:
    *   matrix.setCallback(matrixCallback);
    */
   void showMessage() {
-    matrix.textFont(font);
-    matrix.beginText(0, 1, 0xFFFFFF);
-    matrix.print(message);
-    matrix.endTextAnimation(SCROLL_LEFT, anim);
-    matrix.loadTextAnimationSequence(anim);
-    matrix.play();
+    render(anim);
+    play(anim);
+  }
+
+  /**
+   * Same as showMessage above, but uses the given animation buffer instead
+   * of the one named anim. This way a sketch can have more than one buffer,
+   * for example a small one for short messages and a large one for long
+   * messages.
+   */
+  void showMessage(AsyncScrollingFrames frames) {
+    render(frames.get());
+    play(frames.get());
+  }
+
+  /**
+   * Draw every frame of the message into the given animation buffer without
+   * showing it. This can be done while a different buffer is playing, then
+   * playMessage shows the prepared frames right away.
+   */
+  void prepareMessage(AsyncScrollingFrames frames) {
+    render(frames.get());
+  }
+
+  /**
+   * Show frames that were drawn with prepareMessage
+   */
+  void playMessage(AsyncScrollingFrames frames) {
+    play(frames.get());
+  }
+
+  /**
+   * The pixels of the given column of the message text, counting from the
+   * first column of the first character, as they appear on the screen. Bit y
+   * is set if the pixel in row y is on. Columns past the end are blank.
+   */
+  uint8_t getColumnPixels(size_t column) const {
+    size_t index = column / font->width;
+    if (index >= length) {
+      return 0;
+    }
+    return AsyncScrollingRender::glyphColumn(
+      *font, getChar(index), column % font->width);
+  }
+
+  /**
+   * The width of the message text in columns
+   */
+  size_t getWidth() const {
+    return length * font->width;
+  }
+
+  /**
+   * Returns true if the message fits on the screen of its matrix, so it is
+   * shown as a still frame instead of scrolling. Continuations are always
+   * scrolled.
+   */
+  bool isStatic() const {
+    return isStatic(*matrix);
+  }
+
+  /**
+   * Set how long, in milliseconds, the message is shown if it fits on the
+   * screen and is not scrolled
+   */
+  void setStaticDuration(uint16_t milliseconds) {
+    staticDuration = milliseconds;
+  }
+
+  /**
+   * Get how long, in milliseconds, the message is shown if it fits on the
+   * screen and is not scrolled
+   */
+  uint16_t getStaticDuration() const {
+    return staticDuration;
+  }
+
+  /**
+   * Get the message that will display. This returns a copy, since borrowed
+   * and flash text is not held in a String, so prefer getLength and getChar
+   * when only a few characters are needed.
+   */
+  String getMessage() const {
+    if (text == nullptr) {
+      return message;
+    }
+
+    String copy;
+    copy.reserve(length);
+    for (size_t i = 0; i < length; i++) {
+      copy += getChar(i);
+    }
+    return copy;
+  }
+
+  /**
+   * Get the number of characters in the message that will display
+   */
+  size_t getLength() const {
+    return length;
   }
 
   /**
-   * Get the message that will display
+   * Get the number of columns of the first character that are skipped when
+   * this message is shown. This is only non-zero for continuations, which
+   * start where the previous message's animation buffer ran out.
    */
-  const String& getMessage() const {
-    return message;
+  size_t getColumnOffset() const {
+    return offset;
+  }
+
+  /**
+   * Get the number of frames the message plays when it scrolls. This is the
+   * width of the text, except for a message from generateMessages that has
+   * a continuation, which stops where its continuation starts. A message
+   * that fits on the screen is a single frame.
+   */
+  size_t getFrameCount() const {
+    if (isStatic()) {
+      return 1;
+    }
+    return frames != 0 ? frames : getWidth() - offset;
+  }
+
+  /**
+   * Get how many milliseconds the message is shown for, when it scrolls one
+   * column every scrollSpeed milliseconds. This is getFrameCount frames, or
+   * the static duration if the message fits on the screen, and is exactly
+   * the time from when AsyncScrollingScroller shows it until it calls its
+   * callback. The matrix calls its callback as soon as the last frame
+   * appears, which is one scrollSpeed earlier for a scrolling message, see
+   * getSequenceDuration.
+   */
+  unsigned long getDuration(unsigned long scrollSpeed) const {
+    if (isStatic()) {
+      return staticDuration;
+    }
+    return getFrameCount() * scrollSpeed;
+  }
+
+  /**
+   * Get how many milliseconds pass from when the message is played as a
+   * sequence, with showMessage or AsyncScrollingPlayer, until the matrix
+   * calls its callback, when matrix.textScrollSpeed is scrollSpeed. The
+   * callback comes as soon as the last frame appears, so getFrameCount
+   * frames take one scrollSpeed less than that many. A message that fits on
+   * the screen takes its static duration.
+   */
+  unsigned long getSequenceDuration(unsigned long scrollSpeed) const {
+    if (isStatic()) {
+      return staticDuration;
+    }
+    size_t frames = getFrameCount();
+    return frames > 0 ? (frames - 1) * scrollSpeed : 0;
+  }
+
+  /**
+   * Get the character at index i of the message that will display
+   */
+  char getChar(size_t i) const {
+    if (text == nullptr) {
+      return message.charAt(i);
+    }
+    return flash ? (char)pgm_read_byte(text + i) : text[i];
   }
 
   /**
@@ -137,85 +512,358 @@ public:
    * hasContinuation. It will return false if the message fits in a single
    * object.
    * 
+   * animMaxChars is the number of frames the animation buffer holds, the
+   * MAX_CHARS given to TEXT_ANIMATION_DEFINE. Prefer the version below that
+   * takes the buffer itself so the two can't get out of sync.
+   *
    * Note that continued messages will have some overlapping characters, which
    * is required for scrolling to work smoothly.
+   *
+   * Returns nullptr if there is not enough memory for all of the objects, or
+   * if the sizes can't be planned, for example a font that is 0 columns wide
+   * or an animation buffer without frames. AsyncScrollingPlan::getError with
+   * the same sizes tells which one.
    */
   static AsyncScrollingMessage* generateMessages(
     const String& message,
     ArduinoLEDMatrix& matrix,
     size_t animMaxChars,
     const Font& font) {
-    return generateMessages(message, matrix, animMaxChars, font, false);
+    return generateMessages(Source(message), matrix, animMaxChars, font);
+  }
+
+  /**
+   * Same as generateMessages above, but if the message fits in a single
+   * object, that object takes over the buffer of the temporary String
+   * instead of copying it, so only the object itself is allocated.
+   */
+  static AsyncScrollingMessage* generateMessages(
+    String&& message,
+    ArduinoLEDMatrix& matrix,
+    size_t animMaxChars,
+    const Font& font) {
+    AsyncScrollingPlan plan(
+      message.length(), font.width, matrix.width(), animMaxChars);
+    if (plan.getChunkCount() == 1) {
+      return new (std::nothrow) AsyncScrollingMessage(
+        std::move(message), matrix, font);
+    }
+    return generateMessages(Source(message), matrix, animMaxChars, font);
+  }
+
+  /**
+   * Same as generateMessages above. Every generated message holds a copy of
+   * its part of the text, so the text can be changed or freed afterwards.
+   */
+  static AsyncScrollingMessage* generateMessages(
+    const char* message,
+    ArduinoLEDMatrix& matrix,
+    size_t animMaxChars,
+    const Font& font) {
+    return generateMessages(String(message), matrix, animMaxChars, font);
+  }
+
+  /**
+   * Same as generateMessages above, but every generated message refers to a
+   * part of the text marked with borrow instead of holding its own copy, so
+   * only the message objects use RAM.
+   */
+  static AsyncScrollingMessage* generateMessages(
+    BorrowedText message,
+    ArduinoLEDMatrix& matrix,
+    size_t animMaxChars,
+    const Font& font) {
+    return generateMessages(
+      Source(message.text, false), matrix, animMaxChars, font);
+  }
+
+  /**
+   * Same as generateMessages above for text stored in flash, such as
+   * F("Hello") or a PROGMEM string cast with FPSTR. Only the message objects
+   * use RAM, the text itself is read from flash when it is shown.
+   */
+  static AsyncScrollingMessage* generateMessages(
+    const __FlashStringHelper* message,
+    ArduinoLEDMatrix& matrix,
+    size_t animMaxChars,
+    const Font& font) {
+    return generateMessages(Source(message), matrix, animMaxChars, font);
+  }
+
+  /**
+   * Same as the generateMessages functions above, but the number of frames
+   * is taken from the animation buffer created with TEXT_ANIMATION_DEFINE,
+   * so every message but the last one fills the buffer completely.
+   *   AsyncScrollingMessage::generateMessages("   Hi", matrix, anim, Font_5x7);
+   */
+  template <typename Text>
+  static AsyncScrollingMessage* generateMessages(
+    Text&& message,
+    ArduinoLEDMatrix& matrix,
+    AsyncScrollingFrames frames,
+    const Font& font) {
+    return generateMessages(
+      std::forward<Text>(message), matrix, frames.getCapacity(), font);
+  }
+
+  /**
+   * The number of frames a TEXT_ANIMATION_DEFINE buffer can hold
+   */
+  template <size_t N>
+  static constexpr size_t getFrameCapacity(const uint32_t (&)[N][4]) {
+    return N - ASYNC_SCROLLING_MESSAGE_RESERVED_FRAMES;
+  }
+
+  /**
+   * Returns true if the string literal text, shown with a font that is
+   * fontWidth columns wide, scrolls completely within the animation buffer
+   * frames without needing continuations. This can be checked when
+   * compiling, see ASYNC_SCROLLING_MESSAGE_ASSERT_FITS.
+   */
+  template <size_t N, size_t M>
+  static constexpr bool fits(
+    const uint32_t (&frames)[N][4],
+    const char (&)[M],
+    size_t fontWidth) {
+    return (M - 1) * fontWidth <= getFrameCapacity(frames);
   }
 
 
 private:
 
+  friend class AsyncScrollingChain;
+  friend class AsyncScrollingPlayer;
+  friend class AsyncScrollingCompactPlaylist;
+  friend class AsyncScrollingPlaylist;
+
+  // where the text of a message comes from. either an owned String, or text
+  // that is referenced in place, in RAM or in flash
+  struct Source {
+    explicit Source(const String& string)
+      : string(&string), text(nullptr), length(string.length()), flash(false) {
+    }
+
+    Source(const char* text, bool flash)
+      : string(nullptr), text(text), length(strlen(text)), flash(flash) {
+    }
+
+    explicit Source(const __FlashStringHelper* text)
+      : string(nullptr),
+        text(reinterpret_cast<const char*>(text)),
+        length(strlen_P(reinterpret_cast<const char*>(text))),
+        flash(true) {
+    }
+
+    const String* string;
+    const char* text;
+    size_t length;
+    bool flash;
+  };
+
   AsyncScrollingMessage(
-    const String& message,
+    const Source& source,
+    size_t start,
+    size_t end,
+    size_t offset,
+    size_t frames,
     ArduinoLEDMatrix& matrix,
     const Font& font,
     bool hContinuation,
     bool iContinuation)
-    : message(message),
-      matrix(matrix),
-      font(font),
+    : message(source.string != nullptr
+      ? source.string->substring(start, end)
+      : noString()),
+      text(source.string != nullptr ? nullptr : source.text + start),
+      length(end - start),
+      matrix(&matrix),
+      font(&font),
+      next(nullptr),
+      offset(offset),
+      flash(source.flash),
       hContinuation(hContinuation),
       iContinuation(iContinuation),
-      next(nullptr) {
+      pooled(false),
+      frames(frames),
+      staticDuration(ASYNC_SCROLLING_MESSAGE_STATIC_DURATION) {
+  }
+
+  void render(uint32_t frames[][4]) {
+    render(*matrix, frames);
+  }
+
+  bool isStatic(ArduinoLEDMatrix& target) const {
+    return !hContinuation && !iContinuation
+      && getWidth() <= (size_t)target.width();
+  }
+
+  void render(ArduinoLEDMatrix& target, uint32_t frames[][4]) {
+    ASYNC_SCROLLING_CPU(RENDER);
+    ASYNC_SCROLLING_TRACE(RENDER_START, length);
+    if (isStatic(target)) {
+      renderStatic(target, frames);
+    } else {
+      // the scroll draws getWidth() - offset frames, until the last column
+      // has left the screen. a part with a continuation ends with the
+      // characters of its last frame, so it draws up to a screen width more
+      // frames than the buffer holds. the matrix only keeps as many as
+      // frames[0][0], the size given to TEXT_ANIMATION_DEFINE, and drops the
+      // rest, which is what makes getFrameCount the number of frames played
+      target.textFont(*font);
+      target.beginText(-(int)offset, 1, 0xFFFFFF);
+      printMessage(target);
+      target.endTextAnimation(SCROLL_LEFT, frames);
+    }
+    ASYNC_SCROLLING_TRACE(RENDER_END, length);
+  }
+
+  // the frames a still message takes in frames, two unless the size given
+  // to TEXT_ANIMATION_DEFINE leaves room for fewer
+  static size_t staticFrames(const uint32_t frames[][4]) {
+    return frames[0][0] < 2 ? frames[0][0] : 2;
+  }
+
+  // a still message is drawn directly, centered, without the matrix's
+  // animation capture, after the rows the matrix library keeps for itself.
+  // the matrix calls the callback when it reaches the last frame of a
+  // sequence, so the frame is listed twice and the first one is held for the
+  // static duration
+  void renderStatic(ArduinoLEDMatrix& target, uint32_t frames[][4]) {
+    size_t count = staticFrames(frames);
+    if (count == 0) {
+      return;
+    }
+    uint32_t* frame = frames[ASYNC_SCROLLING_MESSAGE_RESERVED_FRAMES];
+    int x = ((int)target.width() - (int)getWidth()) / 2;
+    AsyncScrollingRender::clear(frame);
+    AsyncScrollingRender::drawText(
+      frame, x, *font, length, [this](size_t i) { return getChar(i); });
+    frame[3] = staticDuration;
+
+    for (size_t i = 0; i < 4 && count > 1; i++) {
+      frames[ASYNC_SCROLLING_MESSAGE_RESERVED_FRAMES + 1][i] = frame[i];
+    }
+  }
+
+  void play(uint32_t frames[][4]) {
+    play(*matrix, frames);
+  }
+
+  void play(ArduinoLEDMatrix& target, uint32_t frames[][4]) {
+    ASYNC_SCROLLING_TRACE(PLAY, isStatic(target));
+    if (!isStatic(target)) {
+      target.loadTextAnimationSequence(frames);
+    } else if (staticFrames(frames) > 0) {
+      target.loadWrapper(&frames[ASYNC_SCROLLING_MESSAGE_RESERVED_FRAMES],
+        staticFrames(frames) * sizeof(frames[0]));
+    } else {
+      return;
+    }
+    target.play();
+  }
+
+  // an empty String that holds no buffer. String() allocates one for the
+  // terminator, a byte of heap for every message that does not own its text
+  static String noString() {
+    return String(static_cast<const char*>(nullptr));
+  }
+
+  // leave a moved from message empty and unlinked
+  void clear() {
+    message = noString();
+    text = nullptr;
+    length = 0;
+    offset = 0;
+    frames = 0;
+    flash = false;
+    hContinuation = false;
+    iContinuation = false;
+    next = nullptr;
+  }
+
+  void printMessage(ArduinoLEDMatrix& target) {
+    if (text == nullptr) {
+      target.print(message);
+      return;
+    }
+
+    // write one character at a time so the text is never copied
+    for (size_t i = 0; i < length; i++) {
+      target.write((uint8_t)getChar(i));
+    }
   }
 
   static AsyncScrollingMessage* generateMessages(
-    const String& message,
+    const Source& source,
     ArduinoLEDMatrix& matrix,
     size_t animMaxChars,
-    const Font& font,
-    bool iContinuation) {
+    const Font& font) {
 
-    // the following code determines if multiple AsyncScrollingMessage objects
-    // are required to display the entire message. In the case where a message
+    // the plan determines if multiple AsyncScrollingMessage objects are
+    // required to display the entire message. In the case where a message
     // has to be split up and a continuation is required, there will be some
     // overlap in the characters stored in each object. this is required to
     // scroll the message smoothly.
     //
-    size_t screenChars = (matrix.width() / font.width);
-    size_t maxFullyScrollChars = animMaxChars / font.width;
-    size_t maxShownChars = maxFullyScrollChars + screenChars;
-
-    bool needsContinue = message.length() > maxFullyScrollChars;
-
-    size_t firstEnd = min(message.length(), maxShownChars);
-    String sub = message.substring(0, firstEnd);
-    AsyncScrollingMessage* am = new AsyncScrollingMessage(
-      sub, matrix, font, needsContinue, iContinuation);
+    // the number of chunks is known before anything is allocated, and is 0
+    // if the sizes can't be planned, so this always ends
+    AsyncScrollingPlan plan(
+      source.length, font.width, matrix.width(), animMaxChars);
 
-    if (!needsContinue) {
-      return am;
+    AsyncScrollingMessage* am = nullptr;
+    AsyncScrollingMessage* last = nullptr;
+    for (size_t i = 0; i < plan.getChunkCount(); i++) {
+      AsyncScrollingPlan::Chunk chunk = plan.getChunk(i);
+      AsyncScrollingMessage* next = new (std::nothrow) AsyncScrollingMessage(
+        source, chunk.start, chunk.end, chunk.offset, chunk.frames, matrix, font,
+        chunk.hasContinuation, chunk.isContinuation);
+      if (next == nullptr) {
+        // a partial chain would end part way through the message
+        deleteChain(am);
+        return nullptr;
+      }
+      if (last == nullptr) {
+        am = next;
+      } else {
+        last->setNext(next);
+      }
+      last = next;
     }
 
-    AsyncScrollingMessage* last = am;
-    size_t start = maxFullyScrollChars;
-    size_t end = min(message.length(), start + maxShownChars);
-
-    while (start < end) {
-      needsContinue = (end < message.length());
-      String nextSub = message.substring(start, end);
-      last = last->setNext(new AsyncScrollingMessage(
-        nextSub, matrix, font, needsContinue, true));
+    return am;
+  }
 
-      start += maxFullyScrollChars;
-      end = min(message.length(), start + maxShownChars);
+  static void deleteChain(AsyncScrollingMessage* message) {
+    while (message != nullptr) {
+      AsyncScrollingMessage* next = message->next;
+      delete message;
+      message = next;
     }
-
-    return am;
   }
 
-  const String message;
-  ArduinoLEDMatrix& matrix;
-  const Font& font;
-  bool hContinuation;
-  const bool iContinuation;
+  // text is nullptr when the message owns its text in message. otherwise
+  // text points to length characters, in flash if flash is true.
+  // offset is the number of columns of the first character that are
+  // skipped because the previous chunk already scrolled them. frames is the
+  // number of frames a chunk from generateMessages plays, or 0 to scroll
+  // the whole text.
+  // matrix and font are pointers so that messages can be move assigned
+  String message;
+  const char* text;
+  size_t length;
+  ArduinoLEDMatrix* matrix;
+  const Font* font;
   AsyncScrollingMessage* next;
+  uint8_t offset;
+
+  // the flags share a single byte. pooled is true if the message belongs to
+  // an AsyncScrollingPlaylist and must not be deleted on its own
+  bool flash : 1;
+  bool hContinuation : 1;
+  bool iContinuation : 1;
+  bool pooled : 1;
+
+  uint16_t frames;
+  uint16_t staticDuration;
 };
 
 #endif
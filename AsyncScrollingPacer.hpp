@@ -0,0 +1,159 @@
+#ifndef _ASYNC_SCROLLING_PACER_HPP_
+#define _ASYNC_SCROLLING_PACER_HPP_
+
+#include "AsyncScrollingClock.hpp"
+
+/**
+ * AsyncScrollingPacer
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Decides when the next frame is due for the scrollers that move frames
+ * themselves. Every frame is due a fixed time after the frame before it was
+ * due, not after it was actually shown, so a frame that is shown late makes
+ * the next one come sooner instead of pushing every frame after it back.
+ * Over a long message, and across continuations shown right after each
+ * other, the scroll stays within one frame of the ideal time.
+ *
+ * The pacer also keeps track of how well it is doing: the frames per second
+ * that were achieved, the latest a frame was shown and how far the last frame
+ * was from the ideal time.
+ */
+class AsyncScrollingPacer {
+public:
+
+  AsyncScrollingPacer()
+    : deadline(0),
+      lastFrame(0),
+      activeMillis(0),
+      frames(0),
+      intervals(0),
+      lateness(0),
+      maxLateness(0),
+      running(false) {
+  }
+
+  /**
+   * Start a new schedule with the first frame shown now, for interval
+   * milliseconds
+   */
+  void start(unsigned long interval) {
+    unsigned long now = AsyncScrollingClock::millis();
+    deadline = now + interval;
+    lastFrame = now;
+    lateness = 0;
+    frames++;
+    running = true;
+  }
+
+  /**
+   * Show a new message right where the last one ended. If the last frame is
+   * still within one interval of when it was due, the first frame of the new
+   * message is counted as the next frame of the same schedule. Otherwise the
+   * scroll was idle and a new schedule starts now.
+   */
+  void resume(unsigned long interval) {
+    unsigned long now = AsyncScrollingClock::millis();
+    if (running && (long)(now - deadline) >= 0 && now - deadline <= interval) {
+      next(interval);
+    } else {
+      start(interval);
+    }
+  }
+
+  /**
+   * Returns true once the current frame has been shown for its interval
+   */
+  bool isDue() const {
+    return running && (long)(AsyncScrollingClock::millis() - deadline) >= 0;
+  }
+
+  /**
+   * The milliseconds until the current frame is due to be replaced, or 0 if
+   * it already is
+   */
+  unsigned long getTimeUntilDue() const {
+    long remaining = (long)(deadline - AsyncScrollingClock::millis());
+    return running && remaining > 0 ? remaining : 0;
+  }
+
+  /**
+   * Count the frame that is shown now, after isDue returned true, and
+   * schedule the one after it interval milliseconds after this one was due.
+   * If frames were missed, the next ones are due right away until the scroll
+   * has caught up.
+   */
+  void next(unsigned long interval) {
+    unsigned long now = AsyncScrollingClock::millis();
+    lateness = (long)(now - deadline);
+    if (lateness > maxLateness) {
+      maxLateness = lateness;
+    }
+    activeMillis += now - lastFrame;
+    lastFrame = now;
+    deadline += interval;
+    frames++;
+    intervals++;
+  }
+
+  /**
+   * Stop the schedule, for example when the last message is done. The
+   * statistics are kept.
+   */
+  void stop() {
+    running = false;
+  }
+
+  /**
+   * The number of frames shown per second while scrolling, leaving out the
+   * time the scroll was idle
+   */
+  float getFramesPerSecond() const {
+    return activeMillis > 0 ? intervals * 1000.0f / activeMillis : 0;
+  }
+
+  /**
+   * The number of frames shown since the statistics were reset
+   */
+  unsigned long getFrameCount() const {
+    return frames;
+  }
+
+  /**
+   * The most milliseconds a frame was shown after it was due
+   */
+  long getMaxLateness() const {
+    return maxLateness;
+  }
+
+  /**
+   * How many milliseconds the last frame was shown after its ideal time.
+   * Since every frame is scheduled from the ideal time of the one before,
+   * this does not grow over a long scroll.
+   */
+  long getDrift() const {
+    return lateness;
+  }
+
+  /**
+   * Start counting frames, lateness and frames per second over
+   */
+  void resetStats() {
+    activeMillis = 0;
+    frames = 0;
+    intervals = 0;
+    maxLateness = 0;
+  }
+
+private:
+
+  unsigned long deadline;
+  unsigned long lastFrame;
+  unsigned long activeMillis;
+  unsigned long frames;
+  unsigned long intervals;
+  long lateness;
+  long maxLateness;
+  bool running;
+};
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef _ASYNC_SCROLLING_PACK_HPP_
+#define _ASYNC_SCROLLING_PACK_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * AsyncScrollingPack
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Reads a pack of messages that were drawn ahead of time on a computer with
+ * extras/pack/make_pack.cpp, so the board does not have to draw any text.
+ * A pack stores every message as columns, one byte per column with bit y set
+ * if the pixel in row y is on, the same as
+ * AsyncScrollingMessage::getColumnPixels. AsyncScrollingPackPlayer scrolls
+ * the columns onto the matrix.
+ *
+ * The layout, with every number stored lowest byte first:
+ *   "ASP1"                      4 bytes
+ *   message count               2 bytes
+ *   reserved                    2 bytes
+ *   one entry for each message:
+ *     column offset             4 bytes, from the start of the pack
+ *     width in columns          2 bytes
+ *     duration                  2 bytes, milliseconds per column, or the
+ *                               time a still message is shown
+ *     flags                     1 byte
+ *     reserved                  3 bytes
+ *   the columns of every message
+ *
+ * This does not depend on the Arduino libraries so the tools that make
+ * packs can read them back.
+ */
+class AsyncScrollingPack {
+public:
+
+  static const size_t HEADER_SIZE = 8;
+  static const size_t ENTRY_SIZE = 12;
+
+  // the message fits on the screen and is shown still, its columns are the
+  // whole screen with the text already centered
+  static const uint8_t STILL = 0x01;
+  // after this message, play continues from the first message
+  static const uint8_t LOOP = 0x02;
+
+  struct Message {
+    uint32_t columnOffset;
+    uint16_t width;
+    uint16_t duration;
+    uint8_t flags;
+  };
+
+  /**
+   * Read the pack of size bytes at data. The data is not copied, so a pack
+   * in a const array is read straight from flash.
+   */
+  AsyncScrollingPack(const uint8_t* data, size_t size)
+    : data(data),
+      size(size),
+      valid(check()) {
+  }
+
+  /**
+   * Returns false if the data is not a pack, or is cut short
+   */
+  bool isValid() const {
+    return valid;
+  }
+
+  /**
+   * The number of messages in the pack, 0 if it is not valid
+   */
+  size_t getMessageCount() const {
+    return valid ? read16(4) : 0;
+  }
+
+  /**
+   * Get the entry of the message at the given index, which has to be less
+   * than getMessageCount
+   */
+  Message getMessage(size_t index) const {
+    size_t entry = HEADER_SIZE + index * ENTRY_SIZE;
+    Message message;
+    message.columnOffset = read32(entry);
+    message.width = read16(entry + 4);
+    message.duration = read16(entry + 6);
+    message.flags = data[entry + 8];
+    return message;
+  }
+
+  /**
+   * The pixels of the given column of a message. Columns past the end are
+   * blank.
+   */
+  uint8_t getColumn(const Message& message, size_t column) const {
+    return column < message.width ? data[message.columnOffset + column] : 0;
+  }
+
+private:
+
+  uint16_t read16(size_t at) const {
+    return (uint16_t)(data[at] | (data[at + 1] << 8));
+  }
+
+  uint32_t read32(size_t at) const {
+    return (uint32_t)read16(at) | ((uint32_t)read16(at + 2) << 16);
+  }
+
+  bool check() const {
+    if (data == nullptr || size < HEADER_SIZE) {
+      return false;
+    }
+    for (size_t i = 0; i < 4; i++) {
+      if (data[i] != "ASP1"[i]) {
+        return false;
+      }
+    }
+    size_t count = read16(4);
+    if (size < HEADER_SIZE + count * ENTRY_SIZE) {
+      return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+      Message message = getMessage(i);
+      if (message.columnOffset > size
+        || message.width > size - message.columnOffset) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const uint8_t* data;
+  size_t size;
+  bool valid;
+};
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef _ASYNC_SCROLLING_PACK_PLAYER_HPP_
+#define _ASYNC_SCROLLING_PACK_PLAYER_HPP_
+
+#include "AsyncScrollingMessage.hpp"
+#include "AsyncScrollingPack.hpp"
+#include "AsyncScrollingPacer.hpp"
+
+/**
+ * AsyncScrollingPackPlayer
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Plays the messages of an AsyncScrollingPack one after the other. Like
+ * AsyncScrollingScroller, it keeps only the frame on the screen and moves it
+ * one column at a time, but the columns come straight from the pack, so no
+ * text is drawn on the board and no animation buffer is needed. Every
+ * message scrolls at the speed stored in the pack.
+ *
+ *   #include "signs.h" // made with extras/pack/make_pack.cpp
+ *   AsyncScrollingPack pack(signs, sizeof(signs));
+ *   AsyncScrollingPackPlayer player(matrix, pack);
+ *   player.start();
+ *   ...
+ *   void loop() {
+ *     player.update();
+ *   }
+ *
+ * Call update from loop, or call tick from a timer interrupt, but not both.
+ */
+class AsyncScrollingPackPlayer {
+public:
+
+  AsyncScrollingPackPlayer(
+    ArduinoLEDMatrix& matrix,
+    const AsyncScrollingPack& pack)
+    : matrix(&matrix),
+      pack(&pack),
+      callback(nullptr),
+      index(0),
+      frameIndex(0),
+      frameCount(0),
+      playing(false) {
+    AsyncScrollingRender::clear(frame);
+  }
+
+  /**
+   * Set a function that is called every time a message is done. If tick is
+   * called from an interrupt, so is the callback.
+   */
+  void setCallback(voidFuncPtr callback) {
+    this->callback = callback;
+  }
+
+  /**
+   * Start playing at the message with the given index. Nothing is played if
+   * the pack is not valid.
+   */
+  void start(size_t index = 0) {
+    if (index >= pack->getMessageCount()) {
+      playing = false;
+      return;
+    }
+    show(index);
+  }
+
+  /**
+   * Stop playing. The frame on the screen stays there.
+   */
+  void stop() {
+    playing = false;
+  }
+
+  /**
+   * Returns true while a message is playing
+   */
+  bool isPlaying() const {
+    return playing;
+  }
+
+  /**
+   * The index of the message that is playing, or that played last
+   */
+  size_t getMessageIndex() const {
+    return index;
+  }
+
+  /**
+   * Call this from loop as often as possible. It calls tick when the current
+   * frame is due to be replaced, on a fixed schedule like
+   * AsyncScrollingScroller.
+   */
+  void update() {
+    if (playing && pacer.isDue()) {
+      tick();
+    }
+  }
+
+  /**
+   * The pacer that schedules the frames, to see the frames per second that
+   * were achieved and how late frames were shown
+   */
+  const AsyncScrollingPacer& getPacer() const {
+    return pacer;
+  }
+
+  /**
+   * Move the text one column to the left, or go on to the next message if
+   * the last frame was showing. After a message with the LOOP flag play
+   * continues from the first message, after the last message it stops.
+   */
+  void tick() {
+    if (!playing) {
+      return;
+    }
+    ASYNC_SCROLLING_CPU(FRAME);
+
+    frameIndex++;
+    if (frameIndex >= frameCount) {
+      ASYNC_SCROLLING_TRACE(COMPLETE, index);
+      size_t next = (message.flags & AsyncScrollingPack::LOOP) ? 0 : index + 1;
+      if (next < pack->getMessageCount()) {
+        show(next);
+      } else {
+        playing = false;
+      }
+      if (callback != nullptr) {
+        ASYNC_SCROLLING_CPU(CALLBACK);
+        callback();
+      }
+      return;
+    }
+
+    size_t last = AsyncScrollingRender::SCREEN_WIDTH - 1;
+    AsyncScrollingRender::shiftLeft(frame);
+    AsyncScrollingRender::setColumn(
+      frame, last, pack->getColumn(message, frameIndex + last));
+    matrix->loadFrame(frame);
+    pacer.next(message.duration);
+    ASYNC_SCROLLING_TRACE(FRAME, frameIndex);
+  }
+
+private:
+
+  void show(size_t index) {
+    ASYNC_SCROLLING_CPU(FRAME);
+    this->index = index;
+    message = pack->getMessage(index);
+    frameIndex = 0;
+    // like a scrolling message, the last frame shows only the last column.
+    // a still message is its single frame
+    frameCount = (message.flags & AsyncScrollingPack::STILL) ? 1 : message.width;
+    for (size_t x = 0; x < AsyncScrollingRender::SCREEN_WIDTH; x++) {
+      AsyncScrollingRender::setColumn(frame, x, pack->getColumn(message, x));
+    }
+    matrix->loadFrame(frame);
+    pacer.resume(message.duration);
+    playing = true;
+    ASYNC_SCROLLING_TRACE(PLAY, index);
+  }
+
+  ArduinoLEDMatrix* matrix;
+  const AsyncScrollingPack* pack;
+  voidFuncPtr callback;
+  AsyncScrollingPack::Message message;
+  size_t index;
+  size_t frameIndex;
+  size_t frameCount;
+  AsyncScrollingPacer pacer;
+  bool playing;
+  uint32_t frame[3];
+};
+
+#endif
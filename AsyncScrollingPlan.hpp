@@ -0,0 +1,174 @@
+#ifndef _ASYNC_SCROLLING_PLAN_HPP_
+#define _ASYNC_SCROLLING_PLAN_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * AsyncScrollingPlan
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Works out how a message has to be split into chunks so that each chunk fits
+ * in the animation buffer. This only does the math and does not depend on the
+ * Arduino libraries, so the same rules can be used by AsyncScrollingMessage,
+ * AsyncScrollingPlaylist and by tools that run on a computer.
+ *
+ * The sizes are checked first. If one of them can't be planned, getError
+ * says which one and the plan has no chunks, so code that loops over the
+ * chunks does nothing instead of dividing by zero or looping forever.
+ */
+class AsyncScrollingPlan {
+public:
+
+  enum Error : uint8_t {
+    NONE = 0,
+    // the font is 0 columns wide, or wider than MAX_FONT_WIDTH
+    FONT_WIDTH,
+    // the screen is 0 columns wide
+    SCREEN_WIDTH,
+    // the animation buffer holds no frames, or more than MAX_FRAME_CAPACITY
+    FRAME_CAPACITY,
+    // the message has more columns than a size_t can count
+    LENGTH
+  };
+
+  // the widest font and the most frames per chunk an AsyncScrollingMessage
+  // can store
+  static const size_t MAX_FONT_WIDTH = UINT8_MAX;
+  static const size_t MAX_FRAME_CAPACITY = UINT16_MAX;
+
+  /**
+   * The part of a message shown by one chunk. start and end are character
+   * indexes into the message, end is exclusive. offset is the number of
+   * columns of the start character that were already scrolled off by the
+   * previous chunk, and frames is the number of frames the chunk plays.
+   */
+  struct Chunk {
+    size_t start;
+    size_t end;
+    size_t offset;
+    size_t frames;
+    bool hasContinuation;
+    bool isContinuation;
+  };
+
+  /**
+   * Plan a message that is length characters long, using a font that is
+   * fontWidth columns wide on a screen that is screenWidth columns wide.
+   * frameCapacity is the number of frames the animation buffer holds, which
+   * is also the number of columns one chunk can scroll.
+   */
+  AsyncScrollingPlan(
+    size_t length,
+    size_t fontWidth,
+    size_t screenWidth,
+    size_t frameCapacity)
+    : length(length),
+      fontWidth(fontWidth),
+      screenWidth(screenWidth),
+      frameCapacity(frameCapacity),
+      error(check()) {
+  }
+
+  /**
+   * Returns true if the message can be planned
+   */
+  bool isValid() const {
+    return error == NONE;
+  }
+
+  /**
+   * Why the message can't be planned, or NONE if it can
+   */
+  Error getError() const {
+    return error;
+  }
+
+  /**
+   * The number of columns it takes to scroll the entire message, which is
+   * also the total number of frames of all chunks together. It is 0 if the
+   * plan is not valid.
+   */
+  size_t getTotalFrames() const {
+    return isValid() ? length * fontWidth : 0;
+  }
+
+  /**
+   * The number of chunks needed to scroll the entire message, or 0 if the
+   * plan is not valid. This is known before any chunk is created, so the
+   * memory for all of them can be set aside first.
+   */
+  size_t getChunkCount() const {
+    if (!isValid()) {
+      return 0;
+    }
+    size_t totalFrames = getTotalFrames();
+    if (totalFrames <= frameCapacity) {
+      return 1;
+    }
+    return totalFrames / frameCapacity + (totalFrames % frameCapacity != 0);
+  }
+
+  /**
+   * Get the chunk at the given index, which has to be less than
+   * getChunkCount.
+   *
+   * Every chunk but the last one fills the animation buffer to the last
+   * frame, so a chunk can start part way into a character. The last frame of
+   * a chunk still shows a screen of columns after the last one scrolled off,
+   * so the chunk includes every character up to the last column of that
+   * frame and no more. The next chunk starts with the column right after the
+   * last one scrolled off, which is what makes the handoff between chunks
+   * smooth.
+   */
+  Chunk getChunk(size_t index) const {
+    size_t firstFrame = index * frameCapacity;
+    size_t remainingFrames = getTotalFrames() - firstFrame;
+
+    Chunk chunk;
+    chunk.start = firstFrame / fontWidth;
+    chunk.offset = firstFrame % fontWidth;
+    chunk.frames = minimum(remainingFrames, frameCapacity);
+    chunk.end = minimum(
+      length, lastColumn(firstFrame + chunk.frames - 1) / fontWidth + 1);
+    chunk.hasContinuation = remainingFrames > frameCapacity;
+    chunk.isContinuation = index > 0;
+    return chunk;
+  }
+
+private:
+
+  Error check() const {
+    if (fontWidth == 0 || fontWidth > MAX_FONT_WIDTH) {
+      return FONT_WIDTH;
+    }
+    if (screenWidth == 0) {
+      return SCREEN_WIDTH;
+    }
+    if (frameCapacity == 0 || frameCapacity > MAX_FRAME_CAPACITY) {
+      return FRAME_CAPACITY;
+    }
+    // the last column of the last frame has to be countable too
+    if (length > (SIZE_MAX - screenWidth) / fontWidth) {
+      return LENGTH;
+    }
+    return NONE;
+  }
+
+  // the last column of the message that is on the screen in the given frame
+  size_t lastColumn(size_t frame) const {
+    return frame + screenWidth - 1;
+  }
+
+  static size_t minimum(size_t a, size_t b) {
+    return a < b ? a : b;
+  }
+
+  size_t length;
+  size_t fontWidth;
+  size_t screenWidth;
+  size_t frameCapacity;
+  Error error;
+};
+
+#endif
@@ -0,0 +1,344 @@
+#ifndef _ASYNC_SCROLLING_PLAYER_HPP_
+#define _ASYNC_SCROLLING_PLAYER_HPP_
+
+#include "AsyncScrollingMessage.hpp"
+
+/**
+ * AsyncScrollingPlayer
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Shows AsyncScrollingMessages on a matrix using animation buffers the
+ * player is given, instead of the global buffer named anim. The messages are
+ * always shown on the player's matrix. With a second buffer, the player draws
+ * the next message into the idle buffer right after the current one starts
+ * scrolling, so the next message can start as soon as the current one is
+ * done.
+ *
+ *   TEXT_ANIMATION_DEFINE(animA, MAX_CHARS)
+ *   TEXT_ANIMATION_DEFINE(animB, MAX_CHARS)
+ *   AsyncScrollingPlayer player(matrix, animA, animB);
+ *   ...
+ *   current = player.show(current);
+ *
+ * The player can also batch short messages. Consecutive messages that scroll
+ * and fit in the buffer together are drawn one after the other, with a few
+ * blank columns between them, and played as one sequence. This saves the
+ * callback and the pause between each of them. getShowing tells which
+ * message of the batch is on the screen.
+ */
+class AsyncScrollingPlayer {
+public:
+
+  /**
+   * Create a player that uses a single animation buffer
+   */
+  AsyncScrollingPlayer(ArduinoLEDMatrix& matrix, AsyncScrollingFrames frames)
+    : matrix(&matrix),
+      frames{ frames, frames },
+      bufferCount(1),
+      playing(0),
+      prepared(nullptr),
+      showing(nullptr),
+      batchCount{ 0, 0 },
+      batchSpeed(0),
+      separator(0),
+      playStart(0),
+      playDuration(0) {
+  }
+
+  /**
+   * Create a player that switches between two animation buffers so the next
+   * message can be drawn while the current one is scrolling. If the buffers
+   * hold different numbers of frames, the player only uses as many frames
+   * as the smaller one holds, see getFrameCapacity.
+   */
+  AsyncScrollingPlayer(
+    ArduinoLEDMatrix& matrix,
+    AsyncScrollingFrames frames,
+    AsyncScrollingFrames spare)
+    : matrix(&matrix),
+      frames{ frames, spare },
+      bufferCount(2),
+      playing(0),
+      prepared(nullptr),
+      showing(nullptr),
+      batchCount{ 0, 0 },
+      batchSpeed(0),
+      separator(0),
+      playStart(0),
+      playDuration(0) {
+  }
+
+  /**
+   * Start scrolling message and return its next message, or nullptr if
+   * message is the last one. If the player has two buffers, the next message
+   * is drawn into the idle buffer before this returns.
+   *
+   * The matrix should be set up the same way as for
+   * AsyncScrollingMessage::showMessage.
+   */
+  AsyncScrollingMessage* show(AsyncScrollingMessage* message) {
+    size_t buffer = idle();
+    if (message != prepared) {
+      render(message, buffer);
+    }
+    prepared = nullptr;
+    if (batchCount[buffer] > 1) {
+      ASYNC_SCROLLING_TRACE(PLAY, 0);
+      matrix->loadWrapper(&frames[buffer].get()[
+        ASYNC_SCROLLING_MESSAGE_RESERVED_FRAMES],
+        batchFrames(message, batchCount[buffer]) * sizeof(uint32_t[4]));
+      matrix->play();
+    } else {
+      message->play(*matrix, frames[buffer].get());
+    }
+    playing = buffer;
+    showing = message;
+    playStart = AsyncScrollingClock::millis();
+    playDuration = sequenceDuration(message, buffer);
+
+    AsyncScrollingMessage* next = message;
+    for (size_t i = 0; i < batchCount[buffer]; i++) {
+      next = next->getNext();
+    }
+    if (bufferCount > 1 && next != nullptr) {
+      render(next, idle());
+      prepared = next;
+    }
+    return next;
+  }
+
+  /**
+   * Play consecutive messages that scroll together as one sequence when they
+   * fit in the buffer, with separator blank columns between them. The frames
+   * of a batch are drawn by the player, so it needs to know the scroll speed
+   * the matrix was given with matrix.textScrollSpeed.
+   *
+   * Messages that fit on the screen and messages with continuations are never
+   * batched. A message that was already drawn ahead of time is drawn again.
+   */
+  void enableBatching(unsigned long scrollSpeed, uint8_t separator = 2) {
+    batchSpeed = scrollSpeed;
+    this->separator = separator;
+    prepared = nullptr;
+  }
+
+  /**
+   * Go back to playing every message on its own
+   */
+  void disableBatching() {
+    batchSpeed = 0;
+    prepared = nullptr;
+  }
+
+  /**
+   * The number of messages the last call to show started playing
+   */
+  size_t getBatchCount() const {
+    return batchCount[playing];
+  }
+
+  /**
+   * The message that is on the screen right now, worked out from the time
+   * since show was called. Without batching this is the message passed to
+   * show. When a message scrolls off, the message after it in the batch is
+   * returned, so a sketch can poll this from loop to act on every message.
+   * Returns nullptr before the first message is shown.
+   */
+  AsyncScrollingMessage* getShowing() const {
+    if (batchCount[playing] <= 1) {
+      return showing;
+    }
+    size_t frame = (AsyncScrollingClock::millis() - playStart) / batchSpeed;
+    AsyncScrollingMessage* message = showing;
+    for (size_t i = 0; i + 1 < batchCount[playing]; i++) {
+      size_t span = message->getWidth() + separator;
+      if (frame < span) {
+        break;
+      }
+      frame -= span;
+      message = message->getNext();
+    }
+    return message;
+  }
+
+  /**
+   * How far the sequence the last call to show started has played, from 0
+   * when it starts to 1 when the matrix calls its callback, worked out from
+   * the time since show was called and the durations of its frames. A
+   * batch counts as one sequence.
+   */
+  float getProgress() const {
+    if (showing == nullptr) {
+      return 0;
+    }
+    unsigned long elapsed = AsyncScrollingClock::millis() - playStart;
+    if (elapsed >= playDuration) {
+      return 1;
+    }
+    return (float)elapsed / playDuration;
+  }
+
+  /**
+   * Forget the message that was drawn ahead of time, for example after
+   * changing the text or the links of the messages. The next call to show
+   * draws its message again.
+   */
+  void discardPrepared() {
+    prepared = nullptr;
+  }
+
+  /**
+   * The number of frames each of the player's buffers can hold, the smaller
+   * of the two. Use this when creating messages with
+   * AsyncScrollingMessage::generateMessages.
+   */
+  size_t getFrameCapacity() const {
+    size_t capacity = frames[0].getCapacity();
+    size_t spare = frames[1].getCapacity();
+    return spare < capacity ? spare : capacity;
+  }
+
+  /**
+   * The matrix the player shows messages on
+   */
+  ArduinoLEDMatrix& getMatrix() {
+    return *matrix;
+  }
+
+private:
+
+  // draw message, and the messages batched with it, into a buffer
+  void render(AsyncScrollingMessage* message, size_t buffer) {
+    batchCount[buffer] = countBatch(message);
+    if (batchCount[buffer] > 1) {
+      renderBatch(message, batchCount[buffer], frames[buffer].get());
+    } else {
+      message->render(*matrix, frames[buffer].get());
+    }
+  }
+
+  bool isBatchable(const AsyncScrollingMessage* message) const {
+    return !message->hasContinuation() && !message->isContinuation()
+      && !message->isStatic(*matrix)
+      && message->getWidth() <= getFrameCapacity();
+  }
+
+  // the number of messages starting with first that fit in the buffer
+  // together. a message is never batched with itself, so a looping chain
+  // ends the batch when it gets back to first
+  size_t countBatch(AsyncScrollingMessage* first) const {
+    if (batchSpeed == 0 || !isBatchable(first)) {
+      return 1;
+    }
+    size_t count = 1;
+    size_t total = first->getWidth();
+    AsyncScrollingMessage* message = first->getNext();
+    while (message != nullptr && message != first && isBatchable(message)) {
+      total += separator + message->getWidth();
+      if (total > getFrameCapacity()) {
+        break;
+      }
+      count++;
+      message = message->getNext();
+    }
+    return count;
+  }
+
+  // the milliseconds from play until the callback of the sequence in the
+  // buffer, every frame's duration but the last one's, since the matrix
+  // calls the callback when the last frame appears
+  unsigned long sequenceDuration(
+    AsyncScrollingMessage* message, size_t buffer) const {
+    uint32_t (*sequence)[4] = frames[buffer].get();
+    size_t count;
+    if (batchCount[buffer] > 1) {
+      count = batchFrames(message, batchCount[buffer]);
+    } else if (message->isStatic(*matrix)) {
+      count = AsyncScrollingMessage::staticFrames(sequence);
+    } else {
+      count = sequence[0][1] / sizeof(uint32_t[4]);
+    }
+    unsigned long duration = 0;
+    for (size_t i = 0; i + 1 < count; i++) {
+      duration += sequence[ASYNC_SCROLLING_MESSAGE_RESERVED_FRAMES + i][3];
+    }
+    return duration;
+  }
+
+  // like a single message, the last frame of a batch shows only the last
+  // column of the last message
+  size_t batchFrames(AsyncScrollingMessage* first, size_t count) const {
+    size_t total = 0;
+    AsyncScrollingMessage* message = first;
+    for (size_t i = 0; i < count; i++) {
+      total += message->getWidth();
+      message = message->getNext();
+    }
+    return total + (count - 1) * separator;
+  }
+
+  // every frame is the one before it moved one column to the left, with the
+  // next column of the batch added on the right
+  void renderBatch(
+    AsyncScrollingMessage* first, size_t count, uint32_t target[][4]) {
+    ASYNC_SCROLLING_CPU(RENDER);
+    ASYNC_SCROLLING_TRACE(RENDER_START, count);
+    AsyncScrollingMessage* message = first;
+    size_t column = 0;
+    size_t index = 0;
+
+    // the pixels of the next column of the batch, blank in the separators
+    // and after the last message
+    auto nextColumn = [&]() -> uint8_t {
+      while (index < count && column >= message->getWidth() + separator) {
+        column -= message->getWidth() + separator;
+        message = message->getNext();
+        index++;
+      }
+      uint8_t pixels = index < count ? message->getColumnPixels(column) : 0;
+      column++;
+      return pixels;
+    };
+
+    size_t total = batchFrames(first, count);
+    uint32_t* frame = target[ASYNC_SCROLLING_MESSAGE_RESERVED_FRAMES];
+    AsyncScrollingRender::clear(frame);
+    for (size_t x = 0; x < AsyncScrollingRender::SCREEN_WIDTH; x++) {
+      AsyncScrollingRender::setColumn(frame, x, nextColumn());
+    }
+    frame[3] = batchSpeed;
+
+    for (size_t i = 1; i < total; i++) {
+      uint32_t* previous = frame;
+      frame = target[ASYNC_SCROLLING_MESSAGE_RESERVED_FRAMES + i];
+      for (size_t word = 0; word < 4; word++) {
+        frame[word] = previous[word];
+      }
+      AsyncScrollingRender::shiftLeft(frame);
+      AsyncScrollingRender::setColumn(
+        frame, AsyncScrollingRender::SCREEN_WIDTH - 1, nextColumn());
+    }
+    ASYNC_SCROLLING_TRACE(RENDER_END, count);
+  }
+
+  // the buffer that is not playing. with a single buffer this is always
+  // the buffer that is playing
+  size_t idle() const {
+    return bufferCount > 1 ? 1 - playing : 0;
+  }
+
+  ArduinoLEDMatrix* matrix;
+  AsyncScrollingFrames frames[2];
+  size_t bufferCount;
+  size_t playing;
+  AsyncScrollingMessage* prepared;
+  AsyncScrollingMessage* showing;
+  size_t batchCount[2];
+  unsigned long batchSpeed;
+  uint8_t separator;
+  unsigned long playStart;
+  unsigned long playDuration;
+};
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef _ASYNC_SCROLLING_PLAYLIST_HPP_
+#define _ASYNC_SCROLLING_PLAYLIST_HPP_
+
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AsyncScrollingMessage.hpp"
+
+/**
+ * One message for AsyncScrollingPlaylist, the text and the font to show it in
+ */
+struct AsyncScrollingPlaylistItem {
+  const char* text;
+  const Font* font;
+};
+
+/**
+ * AsyncScrollingPlaylist
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Builds a linked list of AsyncScrollingMessages for many messages at once.
+ * Every message object and a copy of every text is placed in a single block
+ * of memory, so building the playlist is one allocation no matter how many
+ * messages or continuations it has, and all of it is freed together when the
+ * playlist is destroyed.
+ *
+ * The messages belong to the playlist, so never delete them individually.
+ */
+class AsyncScrollingPlaylist {
+public:
+
+  /**
+   * Build a playlist of count items in the given order. animMaxChars is the
+   * MAX_CHARS given to TEXT_ANIMATION_DEFINE, just like for
+   * AsyncScrollingMessage::generateMessages. Messages that are too long are
+   * split into continuations the same way generateMessages does.
+   *
+   * The playlist is empty, getMessageCount returns 0, if there is not enough
+   * memory or if one of the items can't be planned, see AsyncScrollingPlan.
+   */
+  AsyncScrollingPlaylist(
+    const AsyncScrollingPlaylistItem* items,
+    size_t count,
+    ArduinoLEDMatrix& matrix,
+    size_t animMaxChars)
+    : arena(nullptr),
+      messageCount(0) {
+
+    // first work out how many message objects and how much text is needed
+    // so the memory for all of it can be allocated once
+    size_t textBytes = 0;
+    for (size_t i = 0; i < count; i++) {
+      size_t length = strlen(items[i].text);
+      AsyncScrollingPlan plan(
+        length, items[i].font->width, matrix.width(), animMaxChars);
+      if (!plan.isValid()) {
+        messageCount = 0;
+        return;
+      }
+      messageCount += plan.getChunkCount();
+      textBytes += length + 1;
+    }
+
+    if (messageCount > (SIZE_MAX - textBytes) / sizeof(AsyncScrollingMessage)) {
+      messageCount = 0;
+      return;
+    }
+    size_t messageBytes = messageCount * sizeof(AsyncScrollingMessage);
+    arena = static_cast<char*>(malloc(messageBytes + textBytes));
+    if (arena == nullptr) {
+      messageCount = 0;
+      return;
+    }
+
+    // then create the messages in place, each one refers to its part of the
+    // copied text, and link them together in order
+    AsyncScrollingMessage* messages = getMessages();
+    char* text = arena + messageBytes;
+    size_t created = 0;
+    for (size_t i = 0; i < count; i++) {
+      size_t length = strlen(items[i].text);
+      memcpy(text, items[i].text, length + 1);
+
+      AsyncScrollingMessage::Source source(text, false);
+      AsyncScrollingPlan plan(
+        length, items[i].font->width, matrix.width(), animMaxChars);
+      for (size_t c = 0; c < plan.getChunkCount(); c++) {
+        AsyncScrollingPlan::Chunk chunk = plan.getChunk(c);
+        AsyncScrollingMessage* message = new (&messages[created])
+          AsyncScrollingMessage(
+            source, chunk.start, chunk.end, chunk.offset, chunk.frames, matrix,
+            *items[i].font,
+            chunk.hasContinuation, chunk.isContinuation);
+        message->pooled = true;
+        if (created > 0) {
+          messages[created - 1].setNext(message);
+        }
+        created++;
+      }
+
+      text += length + 1;
+    }
+  }
+
+  /**
+   * Same as above, but the number of frames is taken from the animation
+   * buffer created with TEXT_ANIMATION_DEFINE
+   */
+  AsyncScrollingPlaylist(
+    const AsyncScrollingPlaylistItem* items,
+    size_t count,
+    ArduinoLEDMatrix& matrix,
+    AsyncScrollingFrames frames)
+    : AsyncScrollingPlaylist(items, count, matrix, frames.getCapacity()) {
+  }
+
+  AsyncScrollingPlaylist(const AsyncScrollingPlaylist&) = delete;
+  AsyncScrollingPlaylist& operator=(const AsyncScrollingPlaylist&) = delete;
+
+  AsyncScrollingPlaylist(AsyncScrollingPlaylist&& other)
+    : arena(other.arena),
+      messageCount(other.messageCount) {
+    other.arena = nullptr;
+    other.messageCount = 0;
+  }
+
+  AsyncScrollingPlaylist& operator=(AsyncScrollingPlaylist&& other) {
+    if (this != &other) {
+      release();
+      arena = other.arena;
+      messageCount = other.messageCount;
+      other.arena = nullptr;
+      other.messageCount = 0;
+    }
+    return *this;
+  }
+
+  ~AsyncScrollingPlaylist() {
+    release();
+  }
+
+  /**
+   * Returns a pointer to the first message, or nullptr if the playlist is
+   * empty or the memory for it could not be allocated.
+   */
+  AsyncScrollingMessage* getFirst() {
+    return messageCount > 0 ? getMessages() : nullptr;
+  }
+
+  /**
+   * The number of message objects in the playlist, including continuations
+   */
+  size_t getMessageCount() const {
+    return messageCount;
+  }
+
+private:
+
+  AsyncScrollingMessage* getMessages() {
+    return reinterpret_cast<AsyncScrollingMessage*>(arena);
+  }
+
+  void release() {
+    AsyncScrollingMessage* messages = getMessages();
+    for (size_t i = 0; i < messageCount; i++) {
+      messages[i].~AsyncScrollingMessage();
+    }
+    free(arena);
+    arena = nullptr;
+    messageCount = 0;
+  }
+
+  // the message objects come first, followed by the text of every item
+  char* arena;
+  size_t messageCount;
+};
+
+#endif
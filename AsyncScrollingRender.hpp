@@ -0,0 +1,138 @@
+#ifndef _ASYNC_SCROLLING_RENDER_HPP_
+#define _ASYNC_SCROLLING_RENDER_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * AsyncScrollingRender
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Draws text into frames in the format the Arduino Uno R4 LED matrix uses:
+ * 12 columns by 8 rows packed into three uint32_t, row by row, starting with
+ * the highest bit. Glyphs are drawn the same way ArduinoGraphics draws them,
+ * so frames made here look the same as frames made by the matrix library.
+ *
+ * This does not depend on the Arduino libraries. Fonts are passed as a
+ * template parameter so that both the ArduinoGraphics Font struct and tools
+ * that run on a computer can use it.
+ */
+class AsyncScrollingRender {
+public:
+
+  static const size_t SCREEN_WIDTH = 12;
+  static const size_t SCREEN_HEIGHT = 8;
+
+  // the row the top of the text is drawn at, the same as the
+  // beginText(x, 1) that AsyncScrollingMessage uses
+  static const size_t TEXT_TOP = 1;
+
+  /**
+   * The pixels of one column of a character as it appears on the screen.
+   * Bit y is set if the pixel in row y is on.
+   */
+  template <typename FontType>
+  static uint8_t glyphColumn(const FontType& font, char c, size_t column) {
+    const uint8_t* glyph = font.data[(uint8_t)c];
+    if (glyph == nullptr) {
+      glyph = font.data[(uint8_t)' '];
+    }
+    if (glyph == nullptr || column >= (size_t)font.width || column >= 8) {
+      return 0;
+    }
+
+    uint8_t pixels = 0;
+    for (size_t row = 0; row < (size_t)font.height; row++) {
+      size_t y = TEXT_TOP + row;
+      if (y < SCREEN_HEIGHT && (glyph[row] & (0x80 >> column))) {
+        pixels |= 1 << y;
+      }
+    }
+    return pixels;
+  }
+
+  /**
+   * Turn every pixel of the frame off
+   */
+  static void clear(uint32_t frame[3]) {
+    frame[0] = 0;
+    frame[1] = 0;
+    frame[2] = 0;
+  }
+
+  /**
+   * Set column x of the frame to the given pixels, as returned by
+   * glyphColumn
+   */
+  static void setColumn(uint32_t frame[3], size_t x, uint8_t pixels) {
+    for (size_t y = 0; y < SCREEN_HEIGHT; y++) {
+      size_t bit = y * SCREEN_WIDTH + x;
+      uint32_t mask = 0x80000000UL >> (bit % 32);
+      if (pixels & (1 << y)) {
+        frame[bit / 32] |= mask;
+      } else {
+        frame[bit / 32] &= ~mask;
+      }
+    }
+  }
+
+  /**
+   * Returns the pixels of column x of the frame
+   */
+  static uint8_t getColumn(const uint32_t frame[3], size_t x) {
+    uint8_t pixels = 0;
+    for (size_t y = 0; y < SCREEN_HEIGHT; y++) {
+      size_t bit = y * SCREEN_WIDTH + x;
+      if (frame[bit / 32] & (0x80000000UL >> (bit % 32))) {
+        pixels |= 1 << y;
+      }
+    }
+    return pixels;
+  }
+
+  /**
+   * Move every pixel of the frame one column to the left. The last column is
+   * left with the pixels of the first column of the row below, so it should
+   * be set with setColumn afterwards.
+   */
+  static void shiftLeft(uint32_t frame[3]) {
+    // the frame is stored row by row, so shifting all 96 bits left by one
+    // moves every pixel one column to the left
+    frame[0] = (frame[0] << 1) | (frame[1] >> 31);
+    frame[1] = (frame[1] << 1) | (frame[2] >> 31);
+    frame[2] = frame[2] << 1;
+  }
+
+  /**
+   * Draw length characters of text, read with getChar(i), into the frame so
+   * that the first column of the text lands on column x. Columns outside the
+   * screen are skipped, x can be negative.
+   */
+  template <typename FontType, typename GetChar>
+  static void drawText(
+    uint32_t frame[3],
+    int x,
+    const FontType& font,
+    size_t length,
+    GetChar getChar) {
+    for (size_t i = 0; i < length; i++) {
+      int charX = x + (int)(i * font.width);
+      if (charX >= (int)SCREEN_WIDTH) {
+        break;
+      }
+      if (charX + font.width <= 0) {
+        continue;
+      }
+
+      char c = getChar(i);
+      for (int column = 0; column < font.width; column++) {
+        int screenX = charX + column;
+        if (screenX >= 0 && screenX < (int)SCREEN_WIDTH) {
+          setColumn(frame, screenX, glyphColumn(font, c, column));
+        }
+      }
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,373 @@
+#ifndef _ASYNC_SCROLLING_SCROLLER_HPP_
+#define _ASYNC_SCROLLING_SCROLLER_HPP_
+
+#include "AsyncScrollingMessage.hpp"
+#include "AsyncScrollingPacer.hpp"
+
+/**
+ * AsyncScrollingScroller
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Scrolls AsyncScrollingMessages without an animation buffer. Instead of
+ * drawing every frame ahead of time, the scroller keeps only the frame on the
+ * screen. On every tick it shifts that frame one column to the left, draws
+ * the next column of the text on the right and loads the frame into the
+ * matrix. Since there is no buffer to fill, a message of any length can be
+ * scrolled as one message, without continuations. Messages with
+ * continuations work too, each one stops where its continuation starts.
+ *
+ * Call update from loop, or call tick from a timer interrupt at the scroll
+ * speed, but not both. update keeps every frame on a fixed schedule with an
+ * AsyncScrollingPacer, so a late frame does not delay the rest of the
+ * message, or the continuations shown right after it. Don't play a sequence
+ * on the matrix, for example with showMessage, while the scroller is
+ * scrolling.
+ *
+ * With setThroughput, the scroller speeds messages up when too many are
+ * waiting, so the ones at the end of the list are not out of date by the
+ * time they are shown.
+ */
+class AsyncScrollingScroller {
+public:
+
+  /**
+   * Create a scroller that moves the text one column every scrollSpeed
+   * milliseconds, like matrix.textScrollSpeed
+   */
+  AsyncScrollingScroller(ArduinoLEDMatrix& matrix, unsigned long scrollSpeed)
+    : matrix(&matrix),
+      message(nullptr),
+      callback(nullptr),
+      scrollSpeed(scrollSpeed),
+      targetMillis(0),
+      minSpeed(scrollSpeed),
+      speed(scrollSpeed),
+      frameIndex(0),
+      frameCount(0),
+      maxStep(1),
+      step(1),
+      queueEnd(nullptr),
+      deadline(0) {
+    AsyncScrollingRender::clear(frame);
+  }
+
+  /**
+   * Set a function that is called when a message is done scrolling. If tick
+   * is called from an interrupt, so is the callback.
+   */
+  void setCallback(voidFuncPtr callback) {
+    this->callback = callback;
+  }
+
+  /**
+   * Set how many milliseconds each column is shown, like
+   * matrix.textScrollSpeed
+   */
+  void setScrollSpeed(unsigned long scrollSpeed) {
+    this->scrollSpeed = scrollSpeed;
+  }
+
+  /**
+   * Speed up when the messages waiting to be shown would take longer than
+   * targetMillis at the normal scroll speed. On every frame, the time the
+   * message and the messages linked after it take is predicted, and the
+   * message scrolls just fast enough for each of them to be done within
+   * targetMillis of when the scroller first saw it, but never faster than
+   * one column every minSpeed milliseconds. If that is still not fast
+   * enough, up to maxStep columns are moved at once. Messages that fit on
+   * the screen are still shown for their static duration. Only the first
+   * 255 messages are counted, and they are walked on every frame.
+   */
+  void setThroughput(
+    unsigned long targetMillis,
+    unsigned long minSpeed,
+    uint8_t maxStep = 1) {
+    this->targetMillis = targetMillis;
+    this->minSpeed = minSpeed;
+    this->maxStep = maxStep > 0 ? maxStep : 1;
+    queueEnd = nullptr;
+  }
+
+  /**
+   * Always scroll at the normal scroll speed again, from the next message on
+   */
+  void disableThroughput() {
+    targetMillis = 0;
+  }
+
+  /**
+   * The milliseconds each frame of the message that is scrolling is shown,
+   * which is less than the scroll speed if setThroughput sped it up
+   */
+  unsigned long getSpeed() const {
+    return speed;
+  }
+
+  /**
+   * The number of columns the text moves every frame, more than 1 only if
+   * setThroughput needed to
+   */
+  uint8_t getStep() const {
+    return step;
+  }
+
+  /**
+   * Start scrolling message. The first frame is shown right away. A message
+   * that fits on the screen is shown centered without scrolling for its
+   * static duration.
+   */
+  void show(AsyncScrollingMessage* message) {
+    ASYNC_SCROLLING_CPU(FRAME);
+    ASYNC_SCROLLING_TRACE(RENDER_START, message->getLength());
+    this->message = message;
+    frameIndex = 0;
+    AsyncScrollingRender::clear(frame);
+
+    if (message->isStatic()) {
+      int x = ((int)AsyncScrollingRender::SCREEN_WIDTH
+        - (int)message->getWidth()) / 2;
+      for (size_t column = 0; column < message->getWidth(); column++) {
+        AsyncScrollingRender::setColumn(
+          frame, x + column, message->getColumnPixels(column));
+      }
+    } else {
+      for (size_t x = 0; x < AsyncScrollingRender::SCREEN_WIDTH; x++) {
+        AsyncScrollingRender::setColumn(
+          frame, x, message->getColumnPixels(message->getColumnOffset() + x));
+      }
+    }
+    frameCount = message->getFrameCount();
+    chooseSpeed();
+
+    matrix->loadFrame(frame);
+    pacer.resume(currentFrameDuration());
+    ASYNC_SCROLLING_TRACE(PLAY, message->isStatic());
+  }
+
+  /**
+   * Returns true while a message is scrolling
+   */
+  bool isScrolling() const {
+    return message != nullptr;
+  }
+
+  /**
+   * Stop scrolling without calling the callback. The frame on the screen
+   * stays. The scroller reads the message on every frame, so call this
+   * before deleting a message that is scrolling, or the chain it is in.
+   */
+  void stop() {
+    message = nullptr;
+    queueEnd = nullptr;
+    pacer.stop();
+  }
+
+  /**
+   * Call this from loop as often as possible. It calls tick when the current
+   * frame is due to be replaced.
+   */
+  void update() {
+    if (message != nullptr && pacer.isDue()) {
+      tick();
+    }
+  }
+
+  /**
+   * The index of the frame on the screen, counting from 0 when the message
+   * was shown
+   */
+  size_t getFrameIndex() const {
+    return frameIndex;
+  }
+
+  /**
+   * The number of frames the message that is scrolling plays, see
+   * AsyncScrollingMessage::getFrameCount
+   */
+  size_t getFrameCount() const {
+    return frameCount;
+  }
+
+  /**
+   * The column of the text, counting from its first column, that is on the
+   * left edge of the screen
+   */
+  size_t getColumn() const {
+    return message != nullptr ? message->getColumnOffset() + frameIndex : 0;
+  }
+
+  /**
+   * The milliseconds until the message that is scrolling is done and the
+   * callback is called, or 0 if no message is scrolling
+   */
+  unsigned long getRemaining() const {
+    if (message == nullptr) {
+      return 0;
+    }
+    size_t framesLeft = (frameCount - frameIndex - 1 + step - 1) / step;
+    return pacer.getTimeUntilDue() + framesLeft * currentFrameDuration();
+  }
+
+  /**
+   * The pacer that schedules the frames, to see the frames per second that
+   * were achieved and how late frames were shown
+   */
+  const AsyncScrollingPacer& getPacer() const {
+    return pacer;
+  }
+
+  /**
+   * Move the text one column to the left, or getStep columns, or finish the
+   * message and call the callback if the last frame was showing. A step
+   * never skips the last frame.
+   */
+  void tick() {
+    if (message == nullptr) {
+      return;
+    }
+    ASYNC_SCROLLING_CPU(FRAME);
+
+    if (frameIndex + 1 >= frameCount) {
+      frameIndex = frameCount;
+      ASYNC_SCROLLING_TRACE(COMPLETE, frameIndex);
+      if (message == queueEnd) {
+        queueEnd = nullptr;
+      }
+      message = nullptr;
+      if (callback != nullptr) {
+        ASYNC_SCROLLING_CPU(CALLBACK);
+        callback();
+      }
+      return;
+    }
+
+    size_t last = AsyncScrollingRender::SCREEN_WIDTH - 1;
+    for (uint8_t i = 0; i < step && frameIndex + 1 < frameCount; i++) {
+      frameIndex++;
+      AsyncScrollingRender::shiftLeft(frame);
+      size_t column = message->getColumnOffset() + frameIndex + last;
+      AsyncScrollingRender::setColumn(
+        frame, last, message->getColumnPixels(column));
+    }
+
+    matrix->loadFrame(frame);
+    if (targetMillis != 0) {
+      chooseSpeed();
+    }
+    pacer.next(speed);
+    ASYNC_SCROLLING_TRACE(FRAME, frameIndex);
+  }
+
+private:
+
+  unsigned long currentFrameDuration() const {
+    return message->isStatic() ? message->getStaticDuration() : speed;
+  }
+
+  // the time per column, in hundredths of a millisecond so a fast speed is
+  // not rounded too far, that scrolls columns within millis, of which
+  // stillMillis go to the still messages
+  static unsigned long long timePerColumn(
+    unsigned long long columns,
+    unsigned long stillMillis,
+    unsigned long millis) {
+    return millis > stillMillis
+      ? (unsigned long long)(millis - stillMillis) * 100 / columns : 0;
+  }
+
+  // pick the speed and step for the rest of the message that is being
+  // shown, so that the messages waiting up to queueEnd are done by the
+  // deadline, and the ones linked after them within targetMillis from now.
+  // this is done on every frame, so messages linked to the end of the queue
+  // while a message scrolls speed it up right away
+  void chooseSpeed() {
+    speed = scrollSpeed;
+    step = 1;
+    if (targetMillis == 0 || message->isStatic()) {
+      return;
+    }
+
+    // the columns still to scroll, and the time of the still messages,
+    // which is not sped up, up to queueEnd and up to the end of the queue
+    unsigned long long columns = 0;
+    unsigned long stillMillis = 0;
+    unsigned long long seenColumns = 0;
+    unsigned long seenStillMillis = 0;
+    bool seen = false;
+    AsyncScrollingMessage* tail = message;
+    AsyncScrollingMessage* queued = message;
+    for (uint8_t n = 0; n < 255 && queued != nullptr; n++) {
+      if (queued->isStatic()) {
+        stillMillis += queued->getStaticDuration();
+      } else if (queued == message) {
+        columns += frameCount - frameIndex;
+      } else {
+        columns += queued->getFrameCount();
+      }
+      if (queued == queueEnd) {
+        seen = true;
+        seenColumns = columns;
+        seenStillMillis = stillMillis;
+      }
+      tail = queued;
+      queued = queued->getNext();
+      if (queued == message) {
+        break;
+      }
+    }
+
+    // the slower of the two times per column would miss the other deadline.
+    // the whole queue then gets the deadline the faster one reaches, which
+    // keeps the messages up to queueEnd on time on the next frames
+    unsigned long now = AsyncScrollingClock::millis();
+    unsigned long long perColumn =
+      timePerColumn(columns, stillMillis, targetMillis);
+    if (seen) {
+      unsigned long left = (long)(deadline - now) > 0 ? deadline - now : 0;
+      unsigned long long seenPerColumn =
+        timePerColumn(seenColumns, seenStillMillis, left);
+      perColumn = seenPerColumn < perColumn ? seenPerColumn : perColumn;
+    }
+    queueEnd = tail;
+    deadline = now + stillMillis + (unsigned long)(perColumn * columns / 100);
+    if (perColumn >= (unsigned long long)scrollSpeed * 100) {
+      return;
+    }
+
+    unsigned long long fastest = (unsigned long long)minSpeed * 100;
+    if (perColumn >= fastest) {
+      speed = perColumn / 100;
+      return;
+    }
+
+    // moving more columns per frame keeps the frames at least minSpeed
+    // apart while the text still moves fast enough
+    speed = minSpeed;
+    if (maxStep > 1) {
+      unsigned long long needed = perColumn > 0
+        ? (fastest + perColumn - 1) / perColumn : maxStep;
+      step = needed < maxStep ? needed : maxStep;
+      if (step > 1 && perColumn * step > fastest) {
+        speed = perColumn * step / 100;
+      }
+    }
+  }
+
+  ArduinoLEDMatrix* matrix;
+  AsyncScrollingMessage* message;
+  voidFuncPtr callback;
+  unsigned long scrollSpeed;
+  unsigned long targetMillis;
+  unsigned long minSpeed;
+  unsigned long speed;
+  size_t frameIndex;
+  size_t frameCount;
+  uint8_t maxStep;
+  uint8_t step;
+  AsyncScrollingMessage* queueEnd;
+  unsigned long deadline;
+  AsyncScrollingPacer pacer;
+  uint32_t frame[3];
+};
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef _ASYNC_SCROLLING_STATS_HPP_
+#define _ASYNC_SCROLLING_STATS_HPP_
+
+#include "AsyncScrollingConfig.hpp"
+
+/**
+ * AsyncScrollingStats
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Counts AsyncScrollingMessage objects, to find messages that are never
+ * deleted when a sketch runs for a long time. Counting is only done when
+ * ASYNC_SCROLLING_MESSAGE_STATS is defined before including
+ * AsyncScrollingMessage.hpp, otherwise every count stays zero and nothing is
+ * added to the messages.
+ */
+class AsyncScrollingStats {
+public:
+
+  /**
+   * The number of message objects that exist right now
+   */
+  static unsigned long getLiveMessages() {
+    return getCounts().live;
+  }
+
+  /**
+   * The highest number of message objects that existed at the same time
+   */
+  static unsigned long getPeakMessages() {
+    return getCounts().peak;
+  }
+
+  /**
+   * The number of message objects created since the sketch started
+   */
+  static unsigned long getCreatedMessages() {
+    return getCounts().created;
+  }
+
+  /**
+   * Start the peak over from the number of messages that exist right now
+   */
+  static void resetPeak() {
+    getCounts().peak = getCounts().live;
+  }
+
+  /**
+   * AsyncScrollingMessage derives from this, so every message is counted
+   * when it is created and destroyed, including moved to messages. It has no
+   * members, so it does not make messages any bigger.
+   */
+  class Counted {
+  protected:
+
+    Counted() {
+#ifdef ASYNC_SCROLLING_MESSAGE_STATS
+      Counts& counts = getCounts();
+      counts.created++;
+      counts.live++;
+      if (counts.live > counts.peak) {
+        counts.peak = counts.live;
+      }
+#endif
+    }
+
+    ~Counted() {
+#ifdef ASYNC_SCROLLING_MESSAGE_STATS
+      getCounts().live--;
+#endif
+    }
+  };
+
+private:
+
+  struct Counts {
+    unsigned long live;
+    unsigned long peak;
+    unsigned long created;
+  };
+
+  static Counts& getCounts() {
+    static Counts counts = { 0, 0, 0 };
+    return counts;
+  }
+};
+
+#endif
@@ -0,0 +1,267 @@
+#ifndef _ASYNC_SCROLLING_STREAM_HPP_
+#define _ASYNC_SCROLLING_STREAM_HPP_
+
+#include "AsyncScrollingMessage.hpp"
+#include "AsyncScrollingPacer.hpp"
+
+/**
+ * AsyncScrollingStream
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Scrolls text as it arrives on a Stream, such as Serial, without waiting for
+ * a whole line and without a String or an animation buffer. Bytes are read
+ * into a small buffer that the sketch provides, and every character is
+ * removed from it as soon as its last column has moved onto the screen, so
+ * text of any length can be scrolled with a fixed amount of RAM.
+ *
+ * When the buffer is nearly full, XOFF is sent on the stream to ask the
+ * sender to pause, and XON is sent once there is room again. Terminal
+ * programs and most serial libraries understand this as software flow
+ * control. A newline scrolls the line off the screen before the next line
+ * starts, and calls the callback once it is gone.
+ *
+ *   char streamBuffer[64];
+ *   AsyncScrollingStream serialText(matrix, Serial, streamBuffer, Font_5x7, 60);
+ *   ...
+ *   void loop() {
+ *     serialText.update();
+ *   }
+ */
+class AsyncScrollingStream {
+public:
+
+  static const uint8_t XON = 0x11;
+  static const uint8_t XOFF = 0x13;
+
+  /**
+   * Scroll the text read from stream, one column every scrollSpeed
+   * milliseconds. buffer holds the text that has been read but is not on the
+   * screen yet.
+   */
+  template <size_t N>
+  AsyncScrollingStream(
+    ArduinoLEDMatrix& matrix,
+    Stream& stream,
+    char (&buffer)[N],
+    const Font& font,
+    unsigned long scrollSpeed)
+    : matrix(&matrix),
+      stream(&stream),
+      buffer(buffer),
+      capacity(N),
+      font(&font),
+      callback(nullptr),
+      scrollSpeed(scrollSpeed),
+      head(0),
+      count(0),
+      column(0),
+      blankColumns(0),
+      paused(false),
+      flowControl(true),
+      stalled(true),
+      underruns(0),
+      lines(0) {
+    AsyncScrollingRender::clear(frame);
+  }
+
+  /**
+   * Set a function that is called every time a line has scrolled off the
+   * screen
+   */
+  void setCallback(voidFuncPtr callback) {
+    this->callback = callback;
+  }
+
+  /**
+   * Set how many milliseconds each column is shown
+   */
+  void setScrollSpeed(unsigned long scrollSpeed) {
+    this->scrollSpeed = scrollSpeed;
+  }
+
+  /**
+   * Turn sending XON and XOFF on or off. It is on by default. Without it,
+   * bytes that arrive while the buffer is full wait in the stream.
+   */
+  void setFlowControl(bool enabled) {
+    flowControl = enabled;
+    if (!enabled && paused) {
+      paused = false;
+      stream->write(XON);
+    }
+  }
+
+  /**
+   * Call this from loop as often as possible. It reads what has arrived on
+   * the stream and moves the text when it is time to.
+   */
+  void update() {
+    ASYNC_SCROLLING_CPU(FRAME);
+    read();
+    if (stalled || pacer.isDue()) {
+      tick();
+    }
+  }
+
+  /**
+   * Move the text one column to the left. If the next character has not
+   * arrived yet, the text stays where it is, and starts moving again as soon
+   * as it arrives.
+   */
+  void tick() {
+    ASYNC_SCROLLING_CPU(FRAME);
+    if (blankColumns == 0 && count == 0) {
+      if (!stalled) {
+        stalled = true;
+        underruns++;
+      }
+      return;
+    }
+
+    uint8_t pixels = nextColumn();
+    AsyncScrollingRender::shiftLeft(frame);
+    AsyncScrollingRender::setColumn(
+      frame, AsyncScrollingRender::SCREEN_WIDTH - 1, pixels);
+    matrix->loadFrame(frame);
+    // after waiting for text the schedule starts over, so the columns that
+    // were missed are not shown in a rush
+    if (stalled) {
+      stalled = false;
+      pacer.start(scrollSpeed);
+    } else {
+      pacer.next(scrollSpeed);
+    }
+    ASYNC_SCROLLING_TRACE(FRAME, count);
+
+    if (blankColumns == 1) {
+      blankColumns = 0;
+      lines++;
+      ASYNC_SCROLLING_TRACE(COMPLETE, lines);
+      if (callback != nullptr) {
+        ASYNC_SCROLLING_CPU(CALLBACK);
+        callback();
+      }
+    } else if (blankColumns > 0) {
+      blankColumns--;
+    }
+    read();
+  }
+
+  /**
+   * The number of characters waiting in the buffer
+   */
+  size_t getPending() const {
+    return count;
+  }
+
+  /**
+   * Returns true while the sender was asked to pause
+   */
+  bool isPaused() const {
+    return paused;
+  }
+
+  /**
+   * The number of times the text had to stop because the next character had
+   * not arrived yet
+   */
+  unsigned long getUnderruns() const {
+    return underruns;
+  }
+
+  /**
+   * The number of lines that have scrolled off the screen
+   */
+  unsigned long getLines() const {
+    return lines;
+  }
+
+  /**
+   * The pacer that schedules the columns, to see the frames per second that
+   * were achieved and how late frames were shown
+   */
+  const AsyncScrollingPacer& getPacer() const {
+    return pacer;
+  }
+
+private:
+
+  // read everything that fits, then ask the sender to pause while less than
+  // a quarter of the buffer is free, which leaves room for the bytes that are
+  // already on their way, and to go on again once half of it is free
+  void read() {
+    while (count < capacity && stream->available() > 0) {
+      int c = stream->read();
+      if (c < 0) {
+        break;
+      }
+      if (c == XON || c == XOFF || c == '\r') {
+        continue;
+      }
+      buffer[(head + count) % capacity] = (char)c;
+      count++;
+    }
+
+    if (!flowControl) {
+      return;
+    }
+    size_t free = capacity - count;
+    if (!paused && free <= capacity / 4) {
+      paused = true;
+      stream->write(XOFF);
+    } else if (paused && free >= capacity / 2) {
+      paused = false;
+      stream->write(XON);
+    }
+  }
+
+  // the pixels of the next column of text. a character is removed from the
+  // buffer once its last column is used, and a newline turns into a screen
+  // of blank columns so the line scrolls off before the next one starts
+  uint8_t nextColumn() {
+    if (blankColumns > 0) {
+      return 0;
+    }
+
+    char c = buffer[head];
+    if (c == '\n') {
+      remove();
+      blankColumns = AsyncScrollingRender::SCREEN_WIDTH;
+      return 0;
+    }
+
+    uint8_t pixels = AsyncScrollingRender::glyphColumn(*font, c, column);
+    column++;
+    if (column >= (size_t)font->width) {
+      remove();
+    }
+    return pixels;
+  }
+
+  void remove() {
+    head = (head + 1) % capacity;
+    count--;
+    column = 0;
+  }
+
+  ArduinoLEDMatrix* matrix;
+  Stream* stream;
+  char* buffer;
+  size_t capacity;
+  const Font* font;
+  voidFuncPtr callback;
+  unsigned long scrollSpeed;
+  AsyncScrollingPacer pacer;
+  size_t head;
+  size_t count;
+  size_t column;
+  size_t blankColumns;
+  bool paused;
+  bool flowControl;
+  bool stalled;
+  unsigned long underruns;
+  unsigned long lines;
+  uint32_t frame[3];
+};
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef _ASYNC_SCROLLING_TRACE_HPP_
+#define _ASYNC_SCROLLING_TRACE_HPP_
+
+#include "AsyncScrollingConfig.hpp"
+
+#include <atomic>
+
+#include "AsyncScrollingClock.hpp"
+
+/**
+ * AsyncScrollingTrace
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * A small record of what the library did and when, to find out where time
+ * goes on a running board. The library only records events when
+ * ASYNC_SCROLLING_MESSAGE_TRACE is defined before including
+ * AsyncScrollingMessage.hpp, which also sets how many events are kept:
+ *   #define ASYNC_SCROLLING_MESSAGE_TRACE 64
+ *   #include <AsyncScrollingMessage.hpp>
+ *
+ * Events can be recorded from interrupts, such as the matrix callback. Call
+ * dump to write the events to Serial, then turn them into a timeline with
+ * extras/trace/decode_trace.py.
+ */
+class AsyncScrollingTrace {
+public:
+
+  enum Event : uint8_t {
+    // a message started drawing its frames, arg is its length
+    RENDER_START = 1,
+    // a message finished drawing its frames, arg is its length
+    RENDER_END = 2,
+    // a message started playing, arg is 1 if it is a still frame
+    PLAY = 3,
+    // a message finished, recorded by the scroller or by calling record
+    // from the matrix callback, arg is up to the caller
+    COMPLETE = 4,
+    // the scroller moved one column, arg is the frame index
+    FRAME = 5,
+    // for events recorded by the sketch itself
+    USER = 6
+  };
+
+  struct Entry {
+    uint32_t time;
+    uint16_t arg;
+    uint8_t event;
+  };
+
+  /**
+   * Record an event with the current time in microseconds. Safe to call
+   * from an interrupt.
+   */
+  static void record(Event event, uint16_t arg) {
+    AsyncScrollingTrace& trace = instance();
+    uint32_t index = trace.recorded.fetch_add(1, std::memory_order_relaxed);
+    Entry& entry = trace.entries[index % ASYNC_SCROLLING_TRACE_EVENTS];
+    entry.time = AsyncScrollingClock::micros();
+    entry.arg = arg;
+    entry.event = event;
+  }
+
+  /**
+   * Write every kept event to out, oldest first, one event per line:
+   *   ast,<microseconds>,<event>,<arg>
+   * The first line says how many events were recorded in total and how many
+   * were overwritten:
+   *   ast-begin,<recorded>,<lost>
+   * Other output can be mixed in, the decoder only reads lines that start
+   * with "ast".
+   */
+  static void dump(Print& out) {
+    AsyncScrollingTrace& trace = instance();
+    uint32_t recorded = trace.recorded.load();
+    uint32_t kept = recorded < ASYNC_SCROLLING_TRACE_EVENTS
+      ? recorded : ASYNC_SCROLLING_TRACE_EVENTS;
+
+    out.print("ast-begin,");
+    out.print((unsigned long)recorded);
+    out.print(',');
+    out.println((unsigned long)(recorded - kept));
+
+    for (uint32_t i = recorded - kept; i < recorded; i++) {
+      const Entry& entry = trace.entries[i % ASYNC_SCROLLING_TRACE_EVENTS];
+      out.print("ast,");
+      out.print((unsigned long)entry.time);
+      out.print(',');
+      out.print((unsigned int)entry.event);
+      out.print(',');
+      out.println((unsigned int)entry.arg);
+    }
+  }
+
+  /**
+   * Forget every recorded event
+   */
+  static void reset() {
+    instance().recorded.store(0);
+  }
+
+private:
+
+  AsyncScrollingTrace()
+    : recorded(0) {
+  }
+
+  // a single trace shared by everything that includes this header
+  static AsyncScrollingTrace& instance() {
+    static AsyncScrollingTrace trace;
+    return trace;
+  }
+
+  std::atomic<uint32_t> recorded;
+  Entry entries[ASYNC_SCROLLING_TRACE_EVENTS];
+};
+
+#endif
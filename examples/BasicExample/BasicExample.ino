@@ -10,21 +10,24 @@
 #include <Arduino_LED_Matrix.h>
 #include <TextAnimation.h>
 
-// this has to be done before including AsyncScrollingMessage.
+// this creates the animation buffer named anim that showMessage uses.
 // can make this number smaller to use less memory, but messages
 // created using "new AsyncScrollingMessage" will have to be shorter,
 // messages created using generateMessages can be any length
 #define MAX_CHARS 100
 TEXT_ANIMATION_DEFINE(anim, MAX_CHARS)
 
-// after TEXT_ANIMATION_DEFINE, include the AsyncScrollingMessage class
+// include the AsyncScrollingMessage and AsyncScrollingCompletion classes
 #include <AsyncScrollingMessage.hpp>
+#include <AsyncScrollingCompletion.hpp>
 
 // Create a connection to the matrix
 ArduinoLEDMatrix matrix;
 
-// this flag is used to indicate when the message is done scrolling
-bool requestNext = true;
+// counts the messages that are done scrolling. the callback can be called
+// from an interrupt, so this is used instead of a plain bool flag, and no
+// message is missed if two end before loop checks
+AsyncScrollingCompletion done;
 
 // a pointer to the message
 AsyncScrollingMessage* message;
@@ -54,12 +57,15 @@ void setup() {
   message = new AsyncScrollingMessage(
     "   Hello, from Async ", matrix, Font_5x7);
   current = message;
+
+  // let loop show the first message right away
+  done.kick();
 }
 
 // this is called automatically when the async message is done scrolling
-// it is used to set a flag that will be handled in the loop function
+// it counts the message as done, which is handled in the loop function
 void matrixCallback() {
-  requestNext = true;
+  done.signal();
 }
 
 // these variables are for quickly blinking an led in an async.
@@ -69,11 +75,10 @@ const long blinkInterval = 250;
 PinStatus ledState = LOW;
 
 void loop() {
-  // check the flag if ready for the next message. this flag is false
-  // while the message is scrolling, but will become true when the message
-  // has completed scrolling
-  if (requestNext) {
-    requestNext = false;  // mark that the message was handled
+  // check if ready for the next message. poll returns false while the
+  // message is scrolling, and true once for every message that completed
+  // scrolling
+  if (done.poll()) {
 
     // in this example, if loopMessage was set to false, this if statement will
     // be true only once, and the message will be scrolled once, then become false
@@ -81,7 +86,7 @@ void loop() {
     // and the message will scroll over and over while the arduino is running
     if (current != nullptr) {
 
-      // make sure the callback is set so that the requestNext flag is properly set
+      // make sure the callback is set so that done is signaled
       matrix.setCallback(matrixCallback);
 
       // show the scrolling message
@@ -0,0 +1,43 @@
+/*
+ * ArduinoLedMatrixAsyncScrollingMessage SerialTicker
+ * Copyright (c) 2025 Daniel Savaria
+ * Demonstrates scrolling text as it arrives over Serial
+ * Lines of any length can be sent, only a small buffer is used
+ */
+
+// these are the required built-in libraries
+#include <ArduinoGraphics.h>
+#include <Arduino_LED_Matrix.h>
+
+// include the AsyncScrollingStream class. no animation buffer is needed,
+// the text is drawn onto the screen one column at a time
+#include <AsyncScrollingStream.hpp>
+
+// Create a connection to the matrix
+ArduinoLEDMatrix matrix;
+
+// the text that has arrived but is not on the screen yet. when it is nearly
+// full, XOFF is sent to ask the computer to wait, so use a terminal program
+// with software flow control (XON/XOFF) turned on to send long text
+char streamBuffer[64];
+
+// scroll what arrives on Serial, one column every 60 milliseconds
+AsyncScrollingStream serialText(matrix, Serial, streamBuffer, Font_5x7, 60);
+
+// called every time a line has scrolled off the screen
+void lineCallback() {
+  Serial.print("lines shown: ");
+  Serial.println(serialText.getLines());
+}
+
+void setup() {
+  Serial.begin(115200);
+  matrix.begin();
+  serialText.setCallback(lineCallback);
+}
+
+void loop() {
+  // read what has arrived and move the text when it is time to.
+  // nothing here waits, so other code can run in loop too
+  serialText.update();
+}
@@ -0,0 +1,157 @@
+/*
+ * ArduinoLedMatrixAsyncScrollingMessage SoakTest Example
+ * Copyright (c) 2025 Daniel Savaria
+ * Runs the messages from the TakeActionBetweenMessages example over and over
+ * on a virtual clock, so weeks of scrolling go by in minutes, and reports
+ * over Serial whether messages or heap memory are leaking and whether the
+ * scroll timing drifts
+ */
+
+// count message objects so leaks can be reported,
+// this has to be defined before including the library
+#define ASYNC_SCROLLING_MESSAGE_STATS
+
+// these are the required built-in libraries
+#include <ArduinoGraphics.h>
+#include <Arduino_LED_Matrix.h>
+#include <malloc.h>
+
+// the scroller does not need an animation buffer, and it follows the
+// virtual clock, which the matrix's own sequence player can't
+#include "AsyncScrollingChain.hpp"
+#include "AsyncScrollingScroller.hpp"
+#include "AsyncScrollingCompletion.hpp"
+
+// Create a connection to the matrix
+ArduinoLEDMatrix matrix;
+
+// CUSTOMIZATION NOTE: how fast the text scrolls and how many simulated days
+// to run for
+const unsigned long scrollSpeed = 60;
+const unsigned long daysToRun = 30;
+
+const unsigned long millisPerDay = 24UL * 60 * 60 * 1000;
+
+AsyncScrollingScroller scroller(matrix, scrollSpeed);
+
+// counts the messages that are done scrolling, see BasicExample
+AsyncScrollingCompletion done;
+
+// the messages of one round, recreated for every round so that creating and
+// deleting messages is part of the test
+AsyncScrollingChain messages;
+AsyncScrollingMessage* current = nullptr;
+
+// to measure drift, add up how long each message should take, from the
+// moment the first one was shown
+unsigned long long idealMillis = 0;
+unsigned long long startMillis = 0;
+unsigned long long elapsedMillis = 0;
+unsigned long lastClock = 0;
+
+unsigned long messagesShown = 0;
+unsigned long daysReported = 0;
+size_t heapPeak = 0;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+  }
+
+  matrix.begin();
+  scroller.setCallback(matrixCallback);
+
+  // from here on, the library's time only moves when the sketch says so
+  AsyncScrollingClock::startVirtual();
+  lastClock = AsyncScrollingClock::millis();
+
+  Serial.println("day,messages,live,peak,heap,heapPeak,driftMillis");
+
+  // let loop show the first message right away
+  done.kick();
+}
+
+// this is called by the scroller when the message is done scrolling
+void matrixCallback() {
+  done.signal();
+}
+
+// create the same messages as the TakeActionBetweenMessages example,
+// with a short message after each one
+void createRound() {
+  messages = AsyncScrollingChain(
+    new AsyncScrollingMessage("   Hello, from async", matrix, Font_5x7));
+  messages.append(AsyncScrollingChain(
+    new AsyncScrollingMessage(":)", matrix, Font_5x7)));
+  messages.append(AsyncScrollingChain(AsyncScrollingMessage::generateMessages(
+    String("    123456789a123456789b123456789c1234567890d1234567890e"
+      "1234567890g"),
+    matrix, 100, Font_4x6)));
+  messages.append(AsyncScrollingChain(
+    new AsyncScrollingMessage(":)", matrix, Font_5x7)));
+  current = messages.getFirst();
+}
+
+void report() {
+  struct mallinfo heap = mallinfo();
+
+  // idealMillis already includes the message that is scrolling, so it is
+  // compared with when that message will be done, not with the time so far
+  long long drift = (long long)(elapsedMillis + scroller.getRemaining())
+    - (long long)(startMillis + idealMillis);
+
+  Serial.print(daysReported);
+  Serial.print(',');
+  Serial.print(messagesShown);
+  Serial.print(',');
+  Serial.print(AsyncScrollingStats::getLiveMessages());
+  Serial.print(',');
+  Serial.print(AsyncScrollingStats::getPeakMessages());
+  Serial.print(',');
+  Serial.print((unsigned long)heap.uordblks);
+  Serial.print(',');
+  Serial.print((unsigned long)heapPeak);
+  Serial.print(',');
+  Serial.println((long)drift);
+}
+
+void loop() {
+  if (daysReported >= daysToRun) {
+    return;
+  }
+
+  // move the virtual clock one scroll step and let the scroller catch up
+  AsyncScrollingClock::advance(scrollSpeed);
+  unsigned long now = AsyncScrollingClock::millis();
+  elapsedMillis += now - lastClock;
+  lastClock = now;
+  scroller.update();
+
+  if (done.poll()) {
+
+    // when a round is done, delete all of its messages and start a new one
+    if (current == nullptr) {
+      messages.clear();
+      createRound();
+    }
+
+    if (messagesShown == 0) {
+      startMillis = elapsedMillis;
+    }
+    scroller.show(current);
+    messagesShown++;
+    idealMillis += current->getDuration(scrollSpeed);
+    current = current->getNext();
+
+    struct mallinfo heap = mallinfo();
+    if ((size_t)heap.uordblks > heapPeak) {
+      heapPeak = heap.uordblks;
+    }
+  }
+
+  // report once per simulated day
+  if (elapsedMillis >= (unsigned long long)(daysReported + 1) * millisPerDay) {
+    daysReported++;
+    report();
+  }
+}
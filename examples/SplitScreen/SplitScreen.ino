@@ -0,0 +1,70 @@
+/*
+ * ArduinoLedMatrixAsyncScrollingMessage SplitScreen
+ * Copyright (c) 2025 Daniel Savaria
+ * Demonstrates an icon that stays on the left of the matrix while messages
+ * scroll on the rest of it
+ */
+
+// these are the required built-in libraries
+#include <ArduinoGraphics.h>
+#include <Arduino_LED_Matrix.h>
+
+// include the AsyncScrollingCompositor class. no animation buffer is needed,
+// the compositor draws the screen one column at a time
+#include <AsyncScrollingCompositor.hpp>
+#include <AsyncScrollingCompletion.hpp>
+
+// Create a connection to the matrix
+ArduinoLEDMatrix matrix;
+
+// the screen is split into a 3 column region for the icon and a 9 column
+// region for the text, which scrolls one column every 60 milliseconds. text
+// is drawn from the top row of its region, so the text region starts on the
+// second row, where text is drawn on the whole screen
+AsyncScrollingCompositor screen(matrix, 60);
+uint8_t iconRegion;
+uint8_t textRegion;
+
+// a small arrow in the first three columns, in the format of
+// matrix.loadFrame. only the part inside the icon region is shown
+const uint32_t arrow[3] = {
+  0x00000080,
+  0x0C00E00C,
+  0x00800000
+};
+
+// counts the messages that are done scrolling
+AsyncScrollingCompletion done;
+
+// the messages take turns scrolling next to the icon
+AsyncScrollingMessage first("   Split screen", matrix, Font_5x7);
+AsyncScrollingMessage second("   The arrow stays", matrix, Font_5x7);
+AsyncScrollingMessage* current = &first;
+
+// called by the compositor when the text region is done scrolling
+void textCallback() {
+  done.signal();
+}
+
+void setup() {
+  matrix.begin();
+
+  iconRegion = screen.addRegion(0, 0, 3, 8);
+  textRegion = screen.addRegion(3, 1, 9, 7);
+  screen.setFrame(iconRegion, arrow);
+  screen.setCallback(textRegion, textCallback);
+
+  // let loop show the first message right away
+  done.kick();
+}
+
+void loop() {
+  if (done.poll()) {
+    screen.show(textRegion, current);
+    current = current == &first ? &second : &first;
+  }
+
+  // move the text when it is time to, and load the screen if it changed.
+  // nothing here waits, so other code can run in loop too
+  screen.update();
+}
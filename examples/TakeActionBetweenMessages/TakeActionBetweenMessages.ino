@@ -10,21 +10,24 @@
 #include <Arduino_LED_Matrix.h>
 #include <TextAnimation.h>
 
-// this has to be done before including AsyncScrollingMessage.
+// this creates the animation buffer named anim that showMessage uses.
 // can make this number smaller to use less memory, but messages
 // created using "new AsyncScrollingMessage" will have to be shorter,
 // messages created using generateMessages can be any length
 #define MAX_CHARS 100
 TEXT_ANIMATION_DEFINE(anim, MAX_CHARS)
 
-// after TEXT_ANIMATION_DEFINE, include the AsyncScrollingMessage class
+// include the AsyncScrollingMessage and AsyncScrollingCompletion classes
 #include "AsyncScrollingMessage.hpp"
+#include "AsyncScrollingCompletion.hpp"
 
 // Create a connection to the matrix
 ArduinoLEDMatrix matrix;
 
-// this flag is used to indicate when the message is done scrolling
-bool requestNext = true;
+// counts the messages that are done scrolling. the callback can be called
+// from an interrupt, so this is used instead of a plain bool flag, and no
+// message is missed if two end before loop checks
+AsyncScrollingCompletion done;
 
 // a pointer to the first message
 AsyncScrollingMessage* messages = nullptr;
@@ -33,6 +36,15 @@ AsyncScrollingMessage* messages = nullptr;
 AsyncScrollingMessage* previous = nullptr;
 AsyncScrollingMessage* current = nullptr;
 
+// a short message to display in between scrolling messages. it fits on the
+// screen, so it is shown without scrolling for its static duration, and then
+// the callback is called just like when a scrolling message is done
+AsyncScrollingMessage* interstitial = nullptr;
+
+// shown when there are no more messages. it fits on the screen too, so it
+// is drawn as a still frame that stays until something else is shown
+AsyncScrollingMessage finished(":D", matrix, Font_5x7);
+
 // CUSTOMIZATION NOTE: set this to false to display the messages once and then stop
 // set it to true to loop the messages over and over
 bool loopMessage = true;
@@ -54,19 +66,26 @@ void setup() {
   messages = new AsyncScrollingMessage("   Hello, from async", matrix, Font_5x7);
 
   // create a long message with the generateMessage helper
+  // passing anim lets it size each part to fill the animation buffer exactly.
   // this message is too long for one async call, so it will create multiple
   // messages that are marked as having a continuation
   messages->insertNext(AsyncScrollingMessage::generateMessages(
     "    123456789a123456789b123456789c1234567890d1234567890e1234567890g",
-    matrix, MAX_CHARS, Font_4x6));
+    matrix, anim, Font_4x6));
+
+  interstitial = new AsyncScrollingMessage(":)", matrix, Font_5x7);
+  interstitial->setStaticDuration(2000);
 
   current = messages;
+
+  // let loop show the first message right away
+  done.kick();
 }
 
 // this is called automatically when the async message is done scrolling
-// it is used to set a flag that will be handled in the loop function
+// it counts the message as done, which is handled in the loop function
 void matrixCallback() {
-  requestNext = true;
+  done.signal();
 }
 
 // these variables are for quickly blinking an led in an async.
@@ -75,22 +94,17 @@ unsigned long previousBlink = 0;
 const long blinkInterval = 250;
 PinStatus ledState = LOW;
 
-// these are to display short text in between scrolling messages
+// this is to display short text in between scrolling messages
 bool showInterstitial = false;
-bool showingInterstitial = false;
-unsigned long stopInterstitial = 0;
-const long interstitialInterval = 2000;
-String interstitialText = ":)";
 
 void loop() {
   // get the current processor time
   unsigned long currentTime = millis();
 
-  // check the flag if ready for the next message. this flag is false
-  // while the message is scrolling, but will become true when the message
-  // has completed scrolling
-  if (requestNext) {
-    requestNext = false;  // mark that the message was handled
+  // check if ready for the next message. poll returns false while the
+  // message is scrolling, and true once for every message that completed
+  // scrolling
+  if (done.poll()) {
 
     // if not set to loop the messages, the previous message can be deleted
     // from memory since it won't be used anymore
@@ -103,11 +117,11 @@ void loop() {
     // or if it's ready for the next scrolling message
     if (showInterstitial) {
 
-      //set up the values for the short message
+      // show the short message, the callback will signal done
+      // when it has been shown long enough
       showInterstitial = false;
-      showingInterstitial = true;
-      stopInterstitial = currentTime + interstitialInterval;
-      showText(interstitialText);
+      matrix.setCallback(matrixCallback);
+      interstitial->showMessage();
     }
 
     // in this example, if loopMessage was set to false, this if statement will
@@ -122,7 +136,7 @@ void loop() {
       //  when this message is done scrolling
       showInterstitial = !current->hasContinuation();
 
-      // make sure the callback is set so that the requestNext flag is properly set
+      // make sure the callback is set so that done is signaled
       matrix.setCallback(matrixCallback);
 
       // show the scrolling message, also grab the next message.
@@ -143,18 +157,13 @@ void loop() {
       // if current is a nullptr, (in this demo, this happens when the original
       // messages have finished scrolling and loopMessage was set to false).
       // then there are no more messages to display,
-      // so show a static message
-      showText(":D");
+      // so show a static message. the callback is cleared first, so done is
+      // not signaled again and the message stays on the screen
+      matrix.setCallback(nullptr);
+      finished.showMessage();
     }
   }
 
-  // if the short text is being shown and it's timer is up, then
-  // set the flags needed to display the next scrolling message
-  if (showingInterstitial && currentTime > stopInterstitial) {
-    showingInterstitial = false;
-    requestNext = true;
-  }
-
   // check the led timer to see if it should blink
   if (currentTime - previousBlink >= blinkInterval) {
     previousBlink = currentTime;
@@ -167,18 +176,3 @@ void loop() {
     digitalWrite(LED_BUILTIN, ledState);
   }
 }
-
-// helper code to show a short static text
-void showText(const String& text) {
-  // when showing a non-scrolling message, the callback must be cleared
-  matrix.setCallback(nullptr);
-
-  // basic code to some characters to the LED Matrix
-  matrix.beginDraw();
-  matrix.clear();
-  matrix.stroke(0xFFFFFFFF);
-  matrix.beginText(1, 1, 0xFFFFFF);
-  matrix.print(text);
-  matrix.endText();
-  matrix.endDraw();
-}
@@ -0,0 +1,124 @@
+/**
+ * AsyncScrollingPlan fuzz target
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Feeds AsyncScrollingPlan any message length, font width, screen width and
+ * buffer size, including 0 and sizes close to the largest size_t, and checks
+ * that sizes that can't be planned are reported instead of crashing, and that
+ * the chunks of a valid plan cover every frame of the message exactly once
+ * with nothing missing from the screen.
+ *
+ * Build with clang and libFuzzer on Linux, then run it:
+ *   clang++ -std=c++11 -g -O1 -fsanitize=fuzzer,address,undefined \
+ *     -o fuzz_plan fuzz_plan.cpp
+ *   ./fuzz_plan -max_total_time=60
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../AsyncScrollingPlan.hpp"
+
+// a plan can have more chunks than can be checked in a reasonable time, so
+// only this many at the start and at the end are checked
+static const size_t CHECKED_CHUNKS = 256;
+
+static size_t take(const uint8_t*& data, size_t& size) {
+  size_t value = 0;
+  size_t bytes = size < sizeof(value) ? size : sizeof(value);
+  memcpy(&value, data, bytes);
+  data += bytes;
+  size -= bytes;
+  return value;
+}
+
+// the first bytes pick how large each size may be, so small sizes, which
+// are the ones worth looking at closely, come up often
+static size_t limit(size_t value, uint8_t bits) {
+  return bits >= sizeof(size_t) * 8 ? value : value & (((size_t)1 << bits) - 1);
+}
+
+static void check(bool condition) {
+  if (!condition) {
+    abort();
+  }
+}
+
+static void checkChunk(const AsyncScrollingPlan& plan, size_t index,
+  size_t length, size_t fontWidth, size_t screenWidth, size_t frameCapacity) {
+  size_t chunkCount = plan.getChunkCount();
+  size_t totalFrames = plan.getTotalFrames();
+  AsyncScrollingPlan::Chunk chunk = plan.getChunk(index);
+  size_t firstFrame = index * frameCapacity;
+
+  // the chunk starts right after the frames of the chunks before it
+  check(chunk.start * fontWidth + chunk.offset == firstFrame);
+  check(chunk.offset < fontWidth);
+  check(chunk.frames > 0 && chunk.frames <= frameCapacity);
+  check(chunk.frames <= totalFrames - firstFrame);
+  // every chunk but the last fills the buffer, the last one ends the message
+  check(chunk.hasContinuation == (index + 1 < chunkCount));
+  check(chunk.hasContinuation
+    ? chunk.frames == frameCapacity
+    : firstFrame + chunk.frames == totalFrames);
+  check(chunk.isContinuation == (index > 0));
+
+  // the text of the chunk reaches exactly to the last column on the screen
+  // in its last frame, or to the end of the message
+  check(chunk.start < chunk.end && chunk.end <= length);
+  size_t lastColumn = firstFrame + chunk.frames - 1 + screenWidth - 1;
+  if (chunk.end < length) {
+    check(chunk.end * fontWidth > lastColumn);
+  }
+  check((chunk.end - 1) * fontWidth <= lastColumn);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  if (size < 2) {
+    return 0;
+  }
+  uint8_t bits = data[0];
+  uint8_t capacityBits = data[1] % 65;
+  data += 2;
+  size -= 2;
+
+  size_t length = limit(take(data, size), bits & 0x3F);
+  size_t fontWidth = limit(take(data, size), (bits >> 6) * 4 + 2);
+  size_t screenWidth = limit(take(data, size), 6);
+  size_t frameCapacity = limit(take(data, size), capacityBits);
+
+  AsyncScrollingPlan plan(length, fontWidth, screenWidth, frameCapacity);
+  if (!plan.isValid()) {
+    check(plan.getError() != AsyncScrollingPlan::NONE);
+    check(plan.getChunkCount() == 0);
+    check(plan.getTotalFrames() == 0);
+    return 0;
+  }
+
+  size_t totalFrames = plan.getTotalFrames();
+  size_t chunkCount = plan.getChunkCount();
+  check(totalFrames == length * fontWidth);
+  check(chunkCount >= 1);
+  if (totalFrames > 0) {
+    check((chunkCount - 1) * frameCapacity < totalFrames);
+    check(totalFrames - (chunkCount - 1) * frameCapacity <= frameCapacity);
+  }
+
+  // an empty message has a single chunk without any text
+  if (length == 0) {
+    check(chunkCount == 1);
+    return 0;
+  }
+
+  for (size_t i = 0; i < chunkCount && i < CHECKED_CHUNKS; i++) {
+    checkChunk(plan, i, length, fontWidth, screenWidth, frameCapacity);
+  }
+  size_t last = chunkCount > CHECKED_CHUNKS ? chunkCount - CHECKED_CHUNKS : 0;
+  for (size_t i = last < CHECKED_CHUNKS ? CHECKED_CHUNKS : last;
+    i < chunkCount; i++) {
+    checkChunk(plan, i, length, fontWidth, screenWidth, frameCapacity);
+  }
+  return 0;
+}
@@ -0,0 +1,425 @@
+/**
+ * AsyncScrollingMessage pack maker
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Draws a playlist of messages on a computer and writes the columns to a
+ * pack that AsyncScrollingPackPlayer plays without drawing anything on the
+ * board. The text is drawn with AsyncScrollingRender and the fonts of
+ * ArduinoGraphics, the same way the board draws it, so the result looks the
+ * same.
+ *
+ * The playlist is a text file with one message per line:
+ *   font|milliseconds|flags|text
+ * font is 4x6 or 5x7. milliseconds is how long each column is shown, or how
+ * long a message that fits on the screen is shown. flags is empty or "loop"
+ * to play the first message again after this one. Lines starting with # are
+ * ignored. For example:
+ *   5x7|60||   Welcome
+ *   5x7|2000||:)
+ *   4x6|50|loop|   Open 9 to 5
+ *
+ * Build it with the fonts from the ArduinoGraphics library:
+ *   gcc -c -I ArduinoGraphics/src ArduinoGraphics/src/Font_4x6.c
+ *     ArduinoGraphics/src/Font_5x7.c
+ *   g++ -std=c++11 -O2 -I ArduinoGraphics/src -o make_pack make_pack.cpp
+ *     Font_4x6.o Font_5x7.o
+ *
+ * Then write a header for the sketch, or a binary file:
+ *   ./make_pack signs.txt --header signs.h --name signs
+ *   ./make_pack signs.txt --bin signs.bin
+ *
+ * --verify plays the pack back the way AsyncScrollingPackPlayer does and
+ * checks every frame against the frames the board shows for the same text
+ * with AsyncScrollingMessage: the message is split into parts by
+ * AsyncScrollingPlan for an animation buffer of --frames frames, 100 if not
+ * given, and every frame of every part is drawn pixel by pixel from the font
+ * the way ArduinoGraphics draws it, so a mistake in the columns of the pack
+ * or in where a part starts shows up as a different frame.
+ *
+ * A scrolling message can be at most 65535 columns wide, 13107 characters
+ * of the 5x7 font.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "Font.h"
+
+#include "../../AsyncScrollingPack.hpp"
+#include "../../AsyncScrollingPlan.hpp"
+#include "../../AsyncScrollingRender.hpp"
+
+struct Item {
+  const Font* font;
+  unsigned long duration;
+  bool loop;
+  std::string text;
+  int line;
+};
+
+typedef AsyncScrollingRender Render;
+
+static const size_t MAX_WIDTH = 0xFFFF;
+
+static bool isStill(const Item& item) {
+  return item.text.size() * item.font->width <= Render::SCREEN_WIDTH;
+}
+
+// the columns the pack stores for the item
+static size_t getWidth(const Item& item) {
+  return isStill(item)
+    ? Render::SCREEN_WIDTH
+    : item.text.size() * item.font->width;
+}
+
+static bool parseLine(const std::string& line, int number, Item& item) {
+  size_t first = line.find('|');
+  size_t second = first == std::string::npos
+    ? std::string::npos : line.find('|', first + 1);
+  size_t third = second == std::string::npos
+    ? std::string::npos : line.find('|', second + 1);
+  if (third == std::string::npos) {
+    fprintf(stderr, "line %d: expected font|milliseconds|flags|text\n", number);
+    return false;
+  }
+
+  std::string font = line.substr(0, first);
+  std::string duration = line.substr(first + 1, second - first - 1);
+  std::string flags = line.substr(second + 1, third - second - 1);
+
+  if (font == "4x6") {
+    item.font = &Font_4x6;
+  } else if (font == "5x7") {
+    item.font = &Font_5x7;
+  } else {
+    fprintf(stderr, "line %d: unknown font %s\n", number, font.c_str());
+    return false;
+  }
+
+  char* end;
+  item.duration = strtoul(duration.c_str(), &end, 10);
+  if (duration.empty() || *end != '\0' || item.duration > 0xFFFF) {
+    fprintf(stderr, "line %d: bad milliseconds %s\n", number, duration.c_str());
+    return false;
+  }
+
+  if (flags != "" && flags != "loop") {
+    fprintf(stderr, "line %d: unknown flags %s\n", number, flags.c_str());
+    return false;
+  }
+  item.loop = flags == "loop";
+  item.text = line.substr(third + 1);
+  item.line = number;
+  return true;
+}
+
+static bool readPlaylist(const char* path, std::vector<Item>& items) {
+  FILE* file = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+  if (file == nullptr) {
+    fprintf(stderr, "can't open %s\n", path);
+    return false;
+  }
+
+  bool ok = true;
+  std::string line;
+  int number = 0;
+  int c;
+  do {
+    c = fgetc(file);
+    if (c != EOF && c != '\n') {
+      if (c != '\r') {
+        line += (char)c;
+      }
+      continue;
+    }
+
+    number++;
+    if (!line.empty() && line[0] != '#') {
+      Item item;
+      if (parseLine(line, number, item)) {
+        items.push_back(item);
+      } else {
+        ok = false;
+      }
+    }
+    line.clear();
+  } while (c != EOF);
+
+  if (file != stdin) {
+    fclose(file);
+  }
+  return ok;
+}
+
+// the frame of a still item, centered the way AsyncScrollingMessage draws it
+static void drawStill(const Item& item, uint32_t frame[3]) {
+  const std::string& text = item.text;
+  int x = ((int)Render::SCREEN_WIDTH
+    - (int)(text.size() * item.font->width)) / 2;
+  Render::clear(frame);
+  Render::drawText(frame, x, *item.font, text.size(),
+    [&text](size_t i) { return text[i]; });
+}
+
+// text drawn at x the way ArduinoGraphics does, one pixel at a time from
+// the rows of the font, at the row the library gives beginText. this does
+// not use AsyncScrollingRender, so it checks it as well
+static void drawLikeGraphics(const std::string& text, int x, const Font& font,
+  uint32_t frame[3]) {
+  frame[0] = 0;
+  frame[1] = 0;
+  frame[2] = 0;
+  for (size_t i = 0; i < text.size(); i++) {
+    const uint8_t* glyph = font.data[(uint8_t)text[i]];
+    if (glyph == nullptr) {
+      glyph = font.data[(uint8_t)' '];
+    }
+    if (glyph == nullptr) {
+      continue;
+    }
+    for (int row = 0; row < font.height; row++) {
+      for (int column = 0; column < font.width; column++) {
+        int px = x + (int)i * font.width + column;
+        int py = (int)Render::TEXT_TOP + row;
+        if (px < 0 || px >= 12 || py >= 8
+          || !(glyph[row] & (1 << (7 - column)))) {
+          continue;
+        }
+        size_t bit = py * 12 + px;
+        frame[bit / 32] |= 0x80000000UL >> (bit % 32);
+      }
+    }
+  }
+}
+
+// every frame the board plays for the item with AsyncScrollingMessage and a
+// buffer of frameCapacity frames, part after part
+static std::vector<std::vector<uint32_t>> boardFrames(const Item& item,
+  size_t frameCapacity) {
+  std::vector<std::vector<uint32_t>> frames;
+  uint32_t frame[3];
+  if (isStill(item)) {
+    int x = ((int)Render::SCREEN_WIDTH
+      - (int)(item.text.size() * item.font->width)) / 2;
+    drawLikeGraphics(item.text, x, *item.font, frame);
+    frames.push_back(std::vector<uint32_t>(frame, frame + 3));
+    return frames;
+  }
+
+  AsyncScrollingPlan plan(item.text.size(), item.font->width,
+    Render::SCREEN_WIDTH, frameCapacity);
+  for (size_t c = 0; c < plan.getChunkCount(); c++) {
+    AsyncScrollingPlan::Chunk chunk = plan.getChunk(c);
+    std::string part = item.text.substr(chunk.start, chunk.end - chunk.start);
+    for (size_t f = 0; f < chunk.frames; f++) {
+      drawLikeGraphics(part, -(int)(chunk.offset + f), *item.font, frame);
+      frames.push_back(std::vector<uint32_t>(frame, frame + 3));
+    }
+  }
+  return frames;
+}
+
+static void put16(std::vector<uint8_t>& pack, size_t at, uint32_t value) {
+  pack[at] = value & 0xFF;
+  pack[at + 1] = (value >> 8) & 0xFF;
+}
+
+static std::vector<uint8_t> makePack(const std::vector<Item>& items) {
+  std::vector<uint8_t> pack(AsyncScrollingPack::HEADER_SIZE
+    + items.size() * AsyncScrollingPack::ENTRY_SIZE, 0);
+  memcpy(&pack[0], "ASP1", 4);
+  put16(pack, 4, items.size());
+
+  for (size_t i = 0; i < items.size(); i++) {
+    const Item& item = items[i];
+    size_t offset = pack.size();
+
+    // a scrolling message is stored as the columns of its text. a still
+    // message is stored as the whole screen, already centered
+    uint8_t flags = item.loop ? AsyncScrollingPack::LOOP : 0;
+    size_t width = getWidth(item);
+    if (isStill(item)) {
+      flags |= AsyncScrollingPack::STILL;
+      uint32_t frame[3];
+      drawStill(item, frame);
+      for (size_t x = 0; x < width; x++) {
+        pack.push_back(Render::getColumn(frame, x));
+      }
+    } else {
+      for (size_t column = 0; column < width; column++) {
+        pack.push_back(Render::glyphColumn(*item.font,
+          item.text[column / item.font->width], column % item.font->width));
+      }
+    }
+
+    size_t entry = AsyncScrollingPack::HEADER_SIZE
+      + i * AsyncScrollingPack::ENTRY_SIZE;
+    put16(pack, entry, offset & 0xFFFF);
+    put16(pack, entry + 2, offset >> 16);
+    put16(pack, entry + 4, width);
+    put16(pack, entry + 6, item.duration);
+    pack[entry + 8] = flags;
+  }
+  return pack;
+}
+
+// play every message of the pack the way AsyncScrollingPackPlayer does and
+// compare each frame with the frame the board shows with the library
+static bool verify(const std::vector<Item>& items,
+  const std::vector<uint8_t>& data, size_t frameCapacity) {
+  AsyncScrollingPack pack(data.data(), data.size());
+  if (!pack.isValid() || pack.getMessageCount() != items.size()) {
+    fprintf(stderr, "verify: the pack can't be read back\n");
+    return false;
+  }
+
+  size_t frames = 0;
+  size_t mismatches = 0;
+  for (size_t i = 0; i < items.size(); i++) {
+    AsyncScrollingPack::Message message = pack.getMessage(i);
+    bool still = (message.flags & AsyncScrollingPack::STILL) != 0;
+    size_t frameCount = still ? 1 : message.width;
+    std::vector<std::vector<uint32_t>> expected =
+      boardFrames(items[i], frameCapacity);
+    if (expected.size() != frameCount) {
+      fprintf(stderr, "verify: line %d plays %zu frames, not %zu\n",
+        items[i].line, frameCount, expected.size());
+      mismatches++;
+      continue;
+    }
+
+    uint32_t played[3];
+    Render::clear(played);
+    for (size_t x = 0; x < Render::SCREEN_WIDTH; x++) {
+      Render::setColumn(played, x, pack.getColumn(message, x));
+    }
+
+    for (size_t f = 0; f < frameCount; f++) {
+      if (f > 0) {
+        Render::shiftLeft(played);
+        Render::setColumn(played, Render::SCREEN_WIDTH - 1,
+          pack.getColumn(message, f + Render::SCREEN_WIDTH - 1));
+      }
+      if (memcmp(played, expected[f].data(), sizeof(played)) != 0) {
+        if (mismatches == 0) {
+          fprintf(stderr, "verify: line %d frame %zu is different\n",
+            items[i].line, f);
+        }
+        mismatches++;
+      }
+      frames++;
+    }
+  }
+
+  printf("verify: %zu frames, %zu different\n", frames, mismatches);
+  return mismatches == 0;
+}
+
+static bool writeHeader(const char* path, const char* name,
+  const std::vector<uint8_t>& pack) {
+  FILE* file = fopen(path, "w");
+  if (file == nullptr) {
+    fprintf(stderr, "can't write %s\n", path);
+    return false;
+  }
+  fprintf(file, "// made with extras/pack/make_pack.cpp, %zu bytes\n",
+    pack.size());
+  fprintf(file, "const uint8_t %s[] = {", name);
+  for (size_t i = 0; i < pack.size(); i++) {
+    fprintf(file, i % 12 == 0 ? "\n  0x%02X," : " 0x%02X,", pack[i]);
+  }
+  fprintf(file, "\n};\n");
+  fclose(file);
+  return true;
+}
+
+static bool writeBinary(const char* path, const std::vector<uint8_t>& pack) {
+  FILE* file = fopen(path, "wb");
+  if (file == nullptr) {
+    fprintf(stderr, "can't write %s\n", path);
+    return false;
+  }
+  bool ok = fwrite(pack.data(), 1, pack.size(), file) == pack.size();
+  fclose(file);
+  return ok;
+}
+
+int main(int argc, char** argv) {
+  const char* path = nullptr;
+  const char* header = nullptr;
+  const char* binary = nullptr;
+  const char* name = "pack";
+  bool check = false;
+  unsigned long frameCapacity = 100;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--header") == 0 && i + 1 < argc) {
+      header = argv[++i];
+    } else if (strcmp(argv[i], "--bin") == 0 && i + 1 < argc) {
+      binary = argv[++i];
+    } else if (strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+      name = argv[++i];
+    } else if (strcmp(argv[i], "--verify") == 0) {
+      check = true;
+    } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+      char* end;
+      frameCapacity = strtoul(argv[++i], &end, 10);
+      if (*end != '\0' || frameCapacity == 0) {
+        fprintf(stderr, "bad frames %s\n", argv[i]);
+        return 2;
+      }
+    } else if (path == nullptr && (argv[i][0] != '-' || argv[i][1] == '\0')) {
+      path = argv[i];
+    } else {
+      fprintf(stderr, "bad argument %s\n", argv[i]);
+      return 2;
+    }
+  }
+
+  if (path == nullptr) {
+    fprintf(stderr, "usage: make_pack playlist.txt [--header file.h]"
+      " [--name name] [--bin file.bin] [--verify [--frames N]]\n");
+    return 2;
+  }
+
+  std::vector<Item> items;
+  if (!readPlaylist(path, items)) {
+    return 1;
+  }
+  if (items.empty() || items.size() > 0xFFFF) {
+    fprintf(stderr, "%s has %zu messages\n", path, items.size());
+    return 1;
+  }
+
+  // the pack stores the width in 16 bits
+  bool fits = true;
+  for (const Item& item : items) {
+    if (getWidth(item) > MAX_WIDTH) {
+      fprintf(stderr, "line %d: %zu columns wide, at most %zu fit\n",
+        item.line, getWidth(item), MAX_WIDTH);
+      fits = false;
+    }
+  }
+  if (!fits) {
+    return 1;
+  }
+
+  std::vector<uint8_t> pack = makePack(items);
+  printf("%zu messages, %zu bytes\n", items.size(), pack.size());
+
+  if (check && !verify(items, pack, frameCapacity)) {
+    return 1;
+  }
+  if (header != nullptr && !writeHeader(header, name, pack)) {
+    return 1;
+  }
+  if (binary != nullptr && !writeBinary(binary, pack)) {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,257 @@
+/**
+ * AsyncScrollingMessage terminal preview
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Shows how a message will scroll on the Uno R4 LED matrix without a board.
+ * The message is split into chunks with the same rules as generateMessages
+ * and every frame is drawn with AsyncScrollingRender and the ArduinoGraphics
+ * fonts, then played in the terminal. Before playing, it prints where the
+ * chunks start and end, how many frames each one has, how long the message
+ * takes and what drawing it costs.
+ *
+ * Build it with the fonts from the ArduinoGraphics library:
+ *   gcc -c -I ArduinoGraphics/src ArduinoGraphics/src/Font_4x6.c
+ *     ArduinoGraphics/src/Font_5x7.c
+ *   g++ -std=c++11 -O2 -I ArduinoGraphics/src -o preview preview.cpp
+ *     Font_4x6.o Font_5x7.o
+ *
+ * Run it:
+ *   ./preview "   Hello world" --frames 100 --speed 60
+ *   ./preview --summary < messages.txt
+ *
+ * Options:
+ *   --font 4x6|5x7   the font, default 5x7
+ *   --frames N       MAX_CHARS of the animation buffer, default 100
+ *   --speed MS       milliseconds per frame, default 60
+ *   --hold MS        how long a message that fits is shown, default 2000
+ *   --fast N         play N times faster, 0 shows every frame at once
+ *   --ascii          draw with # and . instead of blocks
+ *   --summary        only print the summary, for scripts
+ *
+ * Without a message on the command line, every line of stdin is a message.
+ * The preview is only played when the output is a terminal.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "Font.h"
+
+#include "../../AsyncScrollingPlan.hpp"
+#include "../../AsyncScrollingRender.hpp"
+
+typedef AsyncScrollingRender Render;
+
+struct Options {
+  const Font* font;
+  size_t frames;
+  unsigned long speed;
+  unsigned long hold;
+  double fast;
+  bool ascii;
+  bool summary;
+};
+
+struct Frame {
+  uint32_t pixels[3];
+  unsigned long duration;
+};
+
+struct ChunkReport {
+  AsyncScrollingPlan::Chunk chunk;
+  size_t glyphs;
+  double microseconds;
+};
+
+// the number of characters that are at least partly on the screen when the
+// text starts at x, which is how many glyphs the matrix library draws for
+// the frame
+static size_t visibleGlyphs(int x, size_t length, size_t fontWidth) {
+  size_t count = 0;
+  for (size_t i = 0; i < length; i++) {
+    int charX = x + (int)(i * fontWidth);
+    if (charX < (int)Render::SCREEN_WIDTH && charX + (int)fontWidth > 0) {
+      count++;
+    }
+  }
+  return count;
+}
+
+// draw every frame of the message the way the board plays it: chunk by
+// chunk, each chunk starting over from its own part of the text
+static void render(const std::string& text, const Options& options,
+  std::vector<Frame>& frames, std::vector<ChunkReport>& chunks) {
+  size_t width = options.font->width;
+  if (text.size() * width <= Render::SCREEN_WIDTH) {
+    Frame frame;
+    frame.duration = options.hold;
+    Render::clear(frame.pixels);
+    int x = ((int)Render::SCREEN_WIDTH - (int)(text.size() * width)) / 2;
+    Render::drawText(frame.pixels, x, *options.font, text.size(),
+      [&text](size_t i) { return text[i]; });
+    frames.push_back(frame);
+    return;
+  }
+
+  AsyncScrollingPlan plan(
+    text.size(), width, Render::SCREEN_WIDTH, options.frames);
+  for (size_t c = 0; c < plan.getChunkCount(); c++) {
+    ChunkReport report;
+    report.chunk = plan.getChunk(c);
+    report.glyphs = 0;
+
+    const char* part = text.c_str() + report.chunk.start;
+    size_t length = report.chunk.end - report.chunk.start;
+    std::chrono::steady_clock::time_point begin =
+      std::chrono::steady_clock::now();
+    for (size_t f = 0; f < report.chunk.frames; f++) {
+      Frame frame;
+      frame.duration = options.speed;
+      int x = -(int)(report.chunk.offset + f);
+      Render::clear(frame.pixels);
+      Render::drawText(frame.pixels, x, *options.font, length,
+        [part](size_t i) { return part[i]; });
+      report.glyphs += visibleGlyphs(x, length, width);
+      frames.push_back(frame);
+    }
+    report.microseconds = std::chrono::duration<double, std::micro>(
+      std::chrono::steady_clock::now() - begin).count();
+    chunks.push_back(report);
+  }
+}
+
+static void printSummary(const std::string& text, const Options& options,
+  const std::vector<Frame>& frames, const std::vector<ChunkReport>& chunks) {
+  unsigned long duration = 0;
+  for (size_t i = 0; i < frames.size(); i++) {
+    duration += frames[i].duration;
+  }
+
+  printf("\"%s\"\n", text.c_str());
+  if (chunks.empty()) {
+    printf("  fits on the screen, shown still for %lu ms\n", duration);
+    return;
+  }
+
+  printf("  %zu characters, %zu columns, %zu chunks, %zu frames, %.1f s\n",
+    text.size(), text.size() * options.font->width, chunks.size(),
+    frames.size(), duration / 1000.0);
+  printf("  %5s %6s %6s %6s %6s %7s %9s\n",
+    "chunk", "start", "end", "offset", "frames", "glyphs", "host us");
+  for (size_t c = 0; c < chunks.size(); c++) {
+    const ChunkReport& report = chunks[c];
+    printf("  %5zu %6zu %6zu %6zu %6zu %7zu %9.1f\n", c, report.chunk.start,
+      report.chunk.end, report.chunk.offset, report.chunk.frames,
+      report.glyphs, report.microseconds);
+  }
+}
+
+static void printFrame(const Frame& frame, bool ascii) {
+  for (size_t y = 0; y < Render::SCREEN_HEIGHT; y++) {
+    std::string row;
+    for (size_t x = 0; x < Render::SCREEN_WIDTH; x++) {
+      bool on = (Render::getColumn(frame.pixels, x) >> y) & 1;
+      if (ascii) {
+        row += on ? "#" : ".";
+      } else {
+        row += on ? "\xE2\x96\x88\xE2\x96\x88" : "  ";
+      }
+    }
+    printf("|%s|\n", row.c_str());
+  }
+}
+
+static void play(const std::vector<Frame>& frames, const Options& options) {
+  for (size_t i = 0; i < frames.size(); i++) {
+    // draw over the last frame, or list the frames one after the other
+    if (i > 0 && options.fast > 0) {
+      printf("\x1B[%zuA", Render::SCREEN_HEIGHT);
+    } else if (i > 0) {
+      printf("\n");
+    }
+    printFrame(frames[i], options.ascii);
+    fflush(stdout);
+    if (options.fast > 0) {
+      long long nanoseconds = (long long)(frames[i].duration * 1e6
+        / options.fast);
+      struct timespec delay = {
+        (time_t)(nanoseconds / 1000000000), (long)(nanoseconds % 1000000000)
+      };
+      nanosleep(&delay, nullptr);
+    }
+  }
+}
+
+static bool parseNumber(const char* text, double& value) {
+  char* end;
+  value = strtod(text, &end);
+  return *text != '\0' && *end == '\0' && value >= 0;
+}
+
+int main(int argc, char** argv) {
+  Options options = { &Font_5x7, 100, 60, 2000, 1, false, false };
+  std::vector<std::string> messages;
+
+  for (int i = 1; i < argc; i++) {
+    double value = 0;
+    bool ok = true;
+    if (strcmp(argv[i], "--font") == 0 && i + 1 < argc) {
+      const char* name = argv[++i];
+      ok = strcmp(name, "4x6") == 0 || strcmp(name, "5x7") == 0;
+      options.font = strcmp(name, "4x6") == 0 ? &Font_4x6 : &Font_5x7;
+    } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+      ok = parseNumber(argv[++i], value) && value >= 1;
+      options.frames = (size_t)value;
+    } else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+      ok = parseNumber(argv[++i], value);
+      options.speed = (unsigned long)value;
+    } else if (strcmp(argv[i], "--hold") == 0 && i + 1 < argc) {
+      ok = parseNumber(argv[++i], value);
+      options.hold = (unsigned long)value;
+    } else if (strcmp(argv[i], "--fast") == 0 && i + 1 < argc) {
+      ok = parseNumber(argv[++i], options.fast);
+    } else if (strcmp(argv[i], "--ascii") == 0) {
+      options.ascii = true;
+    } else if (strcmp(argv[i], "--summary") == 0) {
+      options.summary = true;
+    } else if (argv[i][0] != '-') {
+      messages.push_back(argv[i]);
+    } else {
+      ok = false;
+    }
+    if (!ok) {
+      fprintf(stderr, "bad argument %s\n", argv[i]);
+      return 2;
+    }
+  }
+
+  if (messages.empty()) {
+    char line[1024];
+    while (fgets(line, sizeof(line), stdin) != nullptr) {
+      line[strcspn(line, "\r\n")] = '\0';
+      if (line[0] != '\0') {
+        messages.push_back(line);
+      }
+    }
+  }
+
+  bool animate = !options.summary && isatty(STDOUT_FILENO);
+  for (size_t m = 0; m < messages.size(); m++) {
+    std::vector<Frame> frames;
+    std::vector<ChunkReport> chunks;
+    render(messages[m], options, frames, chunks);
+    printSummary(messages[m], options, frames, chunks);
+    if (animate) {
+      play(frames, options);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,104 @@
+/**
+ * Batching benchmark
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Plays a looping playlist of 50 short messages for one simulated minute,
+ * with and without batching, and prints how many messages were shown and
+ * how many times the matrix called the callback. The sketch is modeled as
+ * a loop that gets to the callback some time after it is called, since on
+ * a board loop is busy with other work, and the next message is only
+ * started then. A batch plays its messages back to back, so it saves a
+ * callback and a delay for every message but its first, at the cost of the
+ * blank columns between them.
+ *
+ *   make build/bench_batching && ./build/bench_batching
+ */
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include "AsyncScrollingPlayer.hpp"
+#include "AsyncScrollingPlaylist.hpp"
+#include "check.h"
+
+TEXT_ANIMATION_DEFINE(animA, 100)
+TEXT_ANIMATION_DEFINE(animB, 100)
+
+static const size_t ITEMS = 50;
+static const unsigned long SCROLL_SPEED = 60;
+static const unsigned long MINUTE = 60000;
+
+static const char* const words[] = {
+  "good", "temp", "21C", "wind", "NNW", "rain", "none", "door", "shut", "mail"
+};
+
+static volatile bool done = false;
+
+static void callback() {
+  done = true;
+}
+
+struct Result {
+  unsigned long messages;
+  unsigned long callbacks;
+};
+
+// play for a minute, starting the next message delay milliseconds after
+// the callback
+static Result run(AsyncScrollingPlaylist& playlist, ArduinoLEDMatrix& matrix,
+  bool batching, unsigned long delay) {
+  AsyncScrollingPlayer player(matrix, animA, animB);
+  if (batching) {
+    player.enableBatching(SCROLL_SPEED);
+  }
+  Result result = { 0, 0 };
+  unsigned long callbacks = matrix.getCallbacks();
+  unsigned long start = millis();
+
+  AsyncScrollingMessage* next = playlist.getFirst();
+  done = false;
+  next = player.show(next);
+  result.messages += player.getBatchCount();
+  while (millis() - start < MINUTE) {
+    HostEmulator::advance(1);
+    if (!done) {
+      continue;
+    }
+    HostEmulator::advance(delay);
+    done = false;
+    next = player.show(next != nullptr ? next : playlist.getFirst());
+    result.messages += player.getBatchCount();
+  }
+  result.callbacks = matrix.getCallbacks() - callbacks;
+  return result;
+}
+
+int main() {
+  ArduinoLEDMatrix matrix;
+  matrix.textScrollSpeed(SCROLL_SPEED);
+  matrix.setCallback(callback);
+
+  AsyncScrollingPlaylistItem items[ITEMS];
+  for (size_t i = 0; i < ITEMS; i++) {
+    items[i].text = words[i % (sizeof(words) / sizeof(words[0]))];
+    items[i].font = &Font_5x7;
+  }
+  AsyncScrollingPlaylist playlist(items, ITEMS, matrix, animA);
+  CHECK_EQUAL(ITEMS, playlist.getMessageCount());
+
+  printf("%zu short messages, %lu ms per column, per minute:\n", ITEMS,
+    SCROLL_SPEED);
+  printf("  delay  messages  callbacks  batched messages  callbacks\n");
+  const unsigned long delays[] = { 0, 20, 100, 250 };
+  for (unsigned long delay : delays) {
+    Result single = run(playlist, matrix, false, delay);
+    Result batched = run(playlist, matrix, true, delay);
+    printf("  %3lu ms %9lu %10lu %17lu %10lu\n", delay, single.messages,
+      single.callbacks, batched.messages, batched.callbacks);
+    CHECK(batched.callbacks * 3 < single.callbacks);
+    if (delay >= 250) {
+      CHECK(batched.messages > single.messages);
+    }
+  }
+  return checkResult("bench_batching");
+}
@@ -0,0 +1,85 @@
+/**
+ * Compositor benchmark
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Prints the time AsyncScrollingCompositor takes per frame with an icon
+ * and a scrolling text region, next to AsyncScrollingScroller scrolling the
+ * same text on the whole screen. A compositor frame moves the text region
+ * and merges every region into the screen, so it costs more than a frame of
+ * the scroller, but it should stay in the same range. The time is measured
+ * on the computer, so only the ratio means much for a board.
+ *
+ *   make build/bench_compositor && ./build/bench_compositor [repeats]
+ */
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include <chrono>
+
+#include "AsyncScrollingCompositor.hpp"
+#include "AsyncScrollingScroller.hpp"
+#include "check.h"
+
+static const unsigned long SCROLL_SPEED = 60;
+
+static const uint32_t arrow[3] = {
+  0x00000080,
+  0x0C00E00C,
+  0x00800000
+};
+
+static const char text[] =
+  "   a message that scrolls next to an icon that stays still";
+
+static double elapsed(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::nano>(
+    std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+  int repeats = argc > 1 ? atoi(argv[1]) : 20000;
+  ArduinoLEDMatrix matrix;
+  AsyncScrollingMessage message(text, matrix, Font_5x7);
+  AsyncScrollingClock::startVirtual();
+
+  AsyncScrollingCompositor screen(matrix, SCROLL_SPEED);
+  uint8_t icon = screen.addRegion(0, 0, 3, 8);
+  uint8_t region = screen.addRegion(3, 1, 9, 7);
+  screen.setFrame(icon, arrow);
+
+  size_t frames = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeats; i++) {
+    screen.show(region, &message);
+    while (screen.isScrolling(region)) {
+      AsyncScrollingClock::advance(SCROLL_SPEED);
+      screen.update();
+      frames++;
+    }
+  }
+  double compositorTime = elapsed(start) / frames;
+  CHECK_EQUAL(message.getWidth() * repeats, frames);
+
+  AsyncScrollingScroller scroller(matrix, SCROLL_SPEED);
+  frames = 0;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeats; i++) {
+    scroller.show(&message);
+    while (scroller.isScrolling()) {
+      AsyncScrollingClock::advance(SCROLL_SPEED);
+      scroller.update();
+      frames++;
+    }
+  }
+  double scrollerTime = elapsed(start) / frames;
+  AsyncScrollingClock::stopVirtual();
+
+  printf("%zu columns of text, per frame:\n", message.getWidth());
+  printf("  compositor, 2 regions  %5zu bytes %8.1f ns\n",
+    sizeof(AsyncScrollingCompositor), compositorTime);
+  printf("  scroller               %5zu bytes %8.1f ns\n",
+    sizeof(AsyncScrollingScroller), scrollerTime);
+  CHECK(compositorTime < scrollerTime * 10);
+  return checkResult("bench_compositor");
+}
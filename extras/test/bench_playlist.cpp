@@ -0,0 +1,126 @@
+/**
+ * Playlist setup benchmark
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Builds the same 1000 messages once with generateMessages for each of
+ * them and once as an AsyncScrollingPlaylist, and prints the time, the
+ * number of allocations and the heap used by each. Both have to produce
+ * the same messages.
+ *
+ *   make build/bench_playlist && ./build/bench_playlist [runs]
+ */
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "AsyncScrollingChain.hpp"
+#include "AsyncScrollingPlaylist.hpp"
+#include "check.h"
+
+TEXT_ANIMATION_DEFINE(anim, 100)
+
+static const size_t ITEMS = 1000;
+static const size_t TEXT_SIZE = 80;
+
+static char texts[ITEMS][TEXT_SIZE];
+static AsyncScrollingPlaylistItem items[ITEMS];
+
+struct Cost {
+  double microseconds;
+  unsigned long allocations;
+  size_t bytes;
+};
+
+static double elapsed(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(
+    std::chrono::steady_clock::now() - start).count();
+}
+
+// every message made with generateMessages, linked one after the other
+static AsyncScrollingMessage* buildEach(ArduinoLEDMatrix& matrix) {
+  AsyncScrollingMessage* first = nullptr;
+  AsyncScrollingMessage* last = nullptr;
+  for (size_t i = 0; i < ITEMS; i++) {
+    AsyncScrollingMessage* message = AsyncScrollingMessage::generateMessages(
+      texts[i], matrix, anim, *items[i].font);
+    if (first == nullptr) {
+      first = message;
+    } else {
+      last->setNext(message);
+    }
+    last = message;
+    while (last->hasNext()) {
+      last = last->getNext();
+    }
+  }
+  return first;
+}
+
+static bool sameMessages(AsyncScrollingMessage* a, AsyncScrollingMessage* b) {
+  for (; a != nullptr && b != nullptr; a = a->getNext(), b = b->getNext()) {
+    if (!(a->getMessage() == b->getMessage().c_str())
+      || a->hasContinuation() != b->hasContinuation()
+      || a->getColumnOffset() != b->getColumnOffset()) {
+      return false;
+    }
+  }
+  return a == nullptr && b == nullptr;
+}
+
+int main(int argc, char** argv) {
+  int runs = argc > 1 ? atoi(argv[1]) : 20;
+  ArduinoLEDMatrix matrix;
+  for (size_t i = 0; i < ITEMS; i++) {
+    snprintf(texts[i], TEXT_SIZE,
+      "   message number %zu with some extra words to make it long", i);
+    items[i].text = texts[i];
+    items[i].font = i % 2 ? &Font_4x6 : &Font_5x7;
+  }
+
+  std::vector<double> eachTimes;
+  std::vector<double> playlistTimes;
+  Cost each = {};
+  Cost playlist = {};
+  size_t messages = 0;
+  for (int run = 0; run < runs; run++) {
+    size_t heap = HostHeap::getLiveBytes();
+    unsigned long allocations = HostHeap::getAllocations();
+    auto start = std::chrono::steady_clock::now();
+    AsyncScrollingChain chain(buildEach(matrix));
+    eachTimes.push_back(elapsed(start));
+    each.allocations = HostHeap::getAllocations() - allocations;
+    each.bytes = HostHeap::getLiveBytes() - heap;
+
+    heap = HostHeap::getLiveBytes();
+    allocations = HostHeap::getAllocations();
+    start = std::chrono::steady_clock::now();
+    AsyncScrollingPlaylist built(items, ITEMS, matrix, anim);
+    playlistTimes.push_back(elapsed(start));
+    playlist.allocations = HostHeap::getAllocations() - allocations;
+    playlist.bytes = HostHeap::getLiveBytes() - heap;
+
+    if (run == 0) {
+      messages = built.getMessageCount();
+      CHECK(messages > ITEMS);
+      CHECK(sameMessages(chain.getFirst(), built.getFirst()));
+    }
+  }
+
+  std::sort(eachTimes.begin(), eachTimes.end());
+  std::sort(playlistTimes.begin(), playlistTimes.end());
+  each.microseconds = eachTimes[eachTimes.size() / 2];
+  playlist.microseconds = playlistTimes[playlistTimes.size() / 2];
+
+  printf("%zu items, %zu messages, median of %d runs\n", ITEMS, messages, runs);
+  printf("  generateMessages  %9.1f us %6lu allocations %8zu bytes\n",
+    each.microseconds, each.allocations, each.bytes);
+  printf("  playlist          %9.1f us %6lu allocations %8zu bytes\n",
+    playlist.microseconds, playlist.allocations, playlist.bytes);
+  CHECK_EQUAL(1, playlist.allocations);
+  CHECK(playlist.bytes < each.bytes);
+  return checkResult("bench_playlist");
+}
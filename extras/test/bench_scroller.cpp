@@ -0,0 +1,138 @@
+/**
+ * Scroller benchmark
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Compares AsyncScrollingScroller, which draws one column per frame, with
+ * playing sequences from an animation buffer. It checks that both put the
+ * same frames on the screen, then prints the RAM each one needs and the
+ * time it takes to draw a frame. The time is measured on the computer, so
+ * only the ratio between the two means much for a board.
+ *
+ *   make build/bench_scroller && ./build/bench_scroller [repeats]
+ */
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include <chrono>
+#include <vector>
+
+#include "AsyncScrollingChain.hpp"
+#include "AsyncScrollingPlayer.hpp"
+#include "AsyncScrollingScroller.hpp"
+#include "check.h"
+
+TEXT_ANIMATION_DEFINE(anim, 100)
+
+typedef std::vector<std::vector<uint32_t>> Frames;
+
+static const char text[] =
+  "   a message that is long enough to need several parts when it is"
+  " played from the animation buffer, but not when it is scrolled";
+
+static void record(ArduinoLEDMatrix& matrix, unsigned long& shown,
+  Frames& frames) {
+  if (matrix.getFramesShown() != shown) {
+    const uint32_t* frame = matrix.getFrame();
+    frames.push_back(std::vector<uint32_t>(frame, frame + 3));
+    shown = matrix.getFramesShown();
+  }
+}
+
+// every frame the matrix shows while the player plays the chain
+static Frames playSequences(ArduinoLEDMatrix& matrix,
+  AsyncScrollingPlayer& player, AsyncScrollingMessage* first) {
+  Frames frames;
+  unsigned long shown = matrix.getFramesShown();
+  for (AsyncScrollingMessage* m = first; m != nullptr; m = m->getNext()) {
+    player.show(m);
+    while (matrix.isPlaying()) {
+      record(matrix, shown, frames);
+      HostEmulator::advance(1);
+    }
+    record(matrix, shown, frames);
+  }
+  return frames;
+}
+
+// every frame the matrix shows while the scroller scrolls the chain
+static Frames scroll(ArduinoLEDMatrix& matrix,
+  AsyncScrollingScroller& scroller, AsyncScrollingMessage* first) {
+  Frames frames;
+  unsigned long shown = matrix.getFramesShown();
+  for (AsyncScrollingMessage* m = first; m != nullptr; m = m->getNext()) {
+    scroller.show(m);
+    while (scroller.isScrolling()) {
+      record(matrix, shown, frames);
+      scroller.tick();
+    }
+  }
+  return frames;
+}
+
+static double elapsed(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::nano>(
+    std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+  int repeats = argc > 1 ? atoi(argv[1]) : 2000;
+  ArduinoLEDMatrix matrix;
+  matrix.textScrollSpeed(60);
+  AsyncScrollingPlayer player(matrix, anim);
+  AsyncScrollingScroller scroller(matrix, 60);
+
+  AsyncScrollingChain parts(AsyncScrollingMessage::generateMessages(
+    text, matrix, anim, Font_5x7));
+  AsyncScrollingMessage whole(text, matrix, Font_5x7);
+  CHECK(parts.getFirst()->hasContinuation());
+
+  // the same frames, whether the parts are played as sequences or
+  // scrolled, and whether the scroller gets the parts or the whole text
+  Frames sequences = playSequences(matrix, player, parts.getFirst());
+  Frames scrolledParts = scroll(matrix, scroller, parts.getFirst());
+  Frames scrolledWhole = scroll(matrix, scroller, &whole);
+  CHECK_EQUAL(whole.getFrameCount(), sequences.size());
+  CHECK(sequences == scrolledParts);
+  CHECK(sequences == scrolledWhole);
+
+  // the time to draw a frame: the scroller draws one column per tick, the
+  // player draws every frame of a part before it plays
+  size_t frames = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeats; i++) {
+    scroller.show(&whole);
+    while (scroller.isScrolling()) {
+      scroller.tick();
+      frames++;
+    }
+  }
+  double scrollerTime = elapsed(start) / frames;
+
+  frames = 0;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeats; i++) {
+    for (AsyncScrollingMessage* m = parts.getFirst(); m != nullptr;
+      m = m->getNext()) {
+      player.show(m);
+      frames += m->getFrameCount();
+    }
+  }
+  double sequenceTime = elapsed(start) / frames;
+
+  size_t count = 0;
+  for (AsyncScrollingMessage* m = parts.getFirst(); m != nullptr;
+    m = m->getNext()) {
+    count++;
+  }
+  printf("%zu frames of %zu characters, %zu parts for a %zu frame buffer\n",
+    whole.getFrameCount(), whole.getLength(), count,
+    AsyncScrollingMessage::getFrameCapacity(anim));
+  printf("  scroller   %5zu bytes %8.1f ns per frame\n",
+    sizeof(AsyncScrollingScroller), scrollerTime);
+  printf("  sequences  %5zu bytes %8.1f ns per frame (buffer %zu, player %zu)"
+    "\n", sizeof(anim) + sizeof(AsyncScrollingPlayer), sequenceTime,
+    sizeof(anim), sizeof(AsyncScrollingPlayer));
+  CHECK(sizeof(AsyncScrollingScroller) < sizeof(anim));
+  return checkResult("bench_scroller");
+}
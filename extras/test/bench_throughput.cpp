@@ -0,0 +1,163 @@
+/**
+ * Throughput benchmark
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Feeds AsyncScrollingScroller a queue of messages that arrive in bursts,
+ * for a few simulated hours on a virtual clock, once at the normal scroll
+ * speed and once with setThroughput, and prints the percentiles of the
+ * latency of a message: the time from when it arrives until it has
+ * scrolled off. Messages are linked to the end of the queue as they arrive,
+ * so the scroller sees every message waiting when it picks a speed.
+ *
+ * Bursts come at random, on average a little more often than the normal
+ * speed can keep up with, so without the policy the queue builds up. With
+ * it, the p99 latency has to stay within the target.
+ *
+ *   make build/bench_throughput && ./build/bench_throughput [hours] [seed]
+ */
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "AsyncScrollingScroller.hpp"
+#include "check.h"
+
+static const unsigned long SCROLL_SPEED = 60;
+static const unsigned long TARGET = 30000;
+static const unsigned long MIN_SPEED = 20;
+static const uint8_t MAX_STEP = 3;
+
+static const char* const texts[] = {
+  "   door open",
+  "   temperature 21C, humidity 40%",
+  "   new mail from the office",
+  "   wind NNW 20 km/h, gusts up to 45 km/h",
+  "   rain expected from 4 pm until late in the evening",
+  "   ok",
+};
+
+static bool done = false;
+
+static void callback() {
+  done = true;
+}
+
+struct Queued {
+  AsyncScrollingMessage* message;
+  unsigned long arrived;
+};
+
+struct Latencies {
+  unsigned long p50;
+  unsigned long p95;
+  unsigned long p99;
+  unsigned long max;
+  size_t shown;
+};
+
+static unsigned long percentile(const std::vector<unsigned long>& sorted,
+  unsigned long percent) {
+  return sorted[(sorted.size() - 1) * percent / 100];
+}
+
+static Latencies run(unsigned long hours, unsigned long seed,
+  bool throughput) {
+  std::mt19937 random(seed);
+  ArduinoLEDMatrix matrix;
+  AsyncScrollingScroller scroller(matrix, SCROLL_SPEED);
+  scroller.setCallback(callback);
+  if (throughput) {
+    scroller.setThroughput(TARGET, MIN_SPEED, MAX_STEP);
+  }
+
+  AsyncScrollingClock::startVirtual();
+  std::deque<Queued> queue;
+  std::vector<unsigned long> latencies;
+  unsigned long end = hours * 60 * 60 * 1000;
+  unsigned long nextBurst = 0;
+  size_t burstLeft = 0;
+  unsigned long nextArrival = 0;
+  bool scrolling = false;
+  done = false;
+
+  for (unsigned long now = 0; now < end; now++) {
+    // a burst every 45 seconds on average, of 1 to 8 messages a quarter of
+    // a second apart
+    if (now >= nextBurst && burstLeft == 0) {
+      burstLeft = 1 + random() % 8;
+      nextArrival = now;
+      nextBurst = now + random() % 90000;
+    }
+    if (burstLeft > 0 && now >= nextArrival) {
+      const char* text = texts[random() % (sizeof(texts) / sizeof(texts[0]))];
+      AsyncScrollingMessage* message =
+        new AsyncScrollingMessage(text, matrix, Font_5x7);
+      if (!queue.empty()) {
+        queue.back().message->setNext(message);
+      }
+      queue.push_back({ message, now });
+      burstLeft--;
+      nextArrival = now + 250;
+    }
+
+    if (done) {
+      done = false;
+      scrolling = false;
+      latencies.push_back(now - queue.front().arrived);
+      delete queue.front().message;
+      queue.pop_front();
+    }
+    if (!scrolling && !queue.empty()) {
+      scroller.show(queue.front().message);
+      scrolling = true;
+    }
+
+    AsyncScrollingClock::advance(1);
+    scroller.update();
+  }
+
+  for (const Queued& queued : queue) {
+    delete queued.message;
+  }
+  AsyncScrollingClock::stopVirtual();
+
+  std::sort(latencies.begin(), latencies.end());
+  Latencies result = { 0, 0, 0, 0, latencies.size() };
+  if (!latencies.empty()) {
+    result.p50 = percentile(latencies, 50);
+    result.p95 = percentile(latencies, 95);
+    result.p99 = percentile(latencies, 99);
+    result.max = latencies.back();
+  }
+  return result;
+}
+
+static void print(const char* name, const Latencies& latencies) {
+  printf("  %-22s %6zu %8.1f %8.1f %8.1f %8.1f\n", name, latencies.shown,
+    latencies.p50 / 1000.0, latencies.p95 / 1000.0, latencies.p99 / 1000.0,
+    latencies.max / 1000.0);
+}
+
+int main(int argc, char** argv) {
+  unsigned long hours = argc > 1 ? strtoul(argv[1], nullptr, 10) : 4;
+  unsigned long seed = argc > 2 ? strtoul(argv[2], nullptr, 10) : 3;
+
+  Latencies fixed = run(hours, seed, false);
+  Latencies policy = run(hours, seed, true);
+  printf("latency from arrival until scrolled off, %lu hours of bursts, "
+    "in seconds:\n", hours);
+  printf("  %-22s %6s %8s %8s %8s %8s\n", "", "shown", "p50", "p95", "p99",
+    "max");
+  print("fixed speed", fixed);
+  print("throughput, 30 s target", policy);
+
+  CHECK(policy.p99 <= TARGET);
+  CHECK(fixed.p99 > TARGET);
+  CHECK(policy.shown >= fixed.shown);
+  return checkResult("bench_throughput");
+}
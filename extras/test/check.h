@@ -0,0 +1,52 @@
+/**
+ * Checks for the host tests
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * CHECK reports a failed condition with its file and line and carries on,
+ * so one run shows every failure. CHECK_EQUAL also prints both values.
+ * Return checkResult() from main, it prints a summary and is 0 only if
+ * every check passed.
+ */
+
+#ifndef _HOST_CHECK_H_
+#define _HOST_CHECK_H_
+
+#include <stdio.h>
+
+inline unsigned long& checkFailures() {
+  static unsigned long failures = 0;
+  return failures;
+}
+
+inline unsigned long& checkCount() {
+  static unsigned long count = 0;
+  return count;
+}
+
+#define CHECK(condition) \
+  do { \
+    checkCount()++; \
+    if (!(condition)) { \
+      checkFailures()++; \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+    } \
+  } while (0)
+
+#define CHECK_EQUAL(expected, actual) \
+  do { \
+    checkCount()++; \
+    long long checkExpected = (long long)(expected); \
+    long long checkActual = (long long)(actual); \
+    if (checkExpected != checkActual) { \
+      checkFailures()++; \
+      printf("%s:%d: expected %s == %lld, got %lld\n", __FILE__, __LINE__, \
+        #actual, checkExpected, checkActual); \
+    } \
+  } while (0)
+
+inline int checkResult(const char* name) {
+  printf("%s: %lu checks, %lu failed\n", name, checkCount(), checkFailures());
+  return checkFailures() == 0 ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""
+Trace decoder check
+Copyright (c) 2025 Daniel Savaria
+
+Decodes the dump test_trace writes with extras/trace/decode_trace.py and
+checks that every part of the chain was drawn, played and completed, in
+that order, with the time never going back. Then checks the decoder on
+made up dumps: an event recorded from an interrupt a little out of order,
+and the microsecond clock wrapping around.
+
+Usage:
+  check_trace.py build/trace.txt
+"""
+
+import os
+import re
+import subprocess
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+DECODER = os.path.join(HERE, "..", "trace", "decode_trace.py")
+sys.path.insert(0, os.path.dirname(DECODER))
+
+from decode_trace import read_events  # noqa: E402
+
+ORDER = ["render start", "render end", "play", "complete"]
+
+# a line of the timeline: time, time since the last event, name, arg, note
+LINE = re.compile(
+    r"^\s*([\d.]+) ms\s+\+\s*(-?\d+) us\s+(.+?)\s+(\d+)(\s+\(.*\))?$")
+
+failures = 0
+
+
+def check(condition, message):
+    global failures
+    if not condition:
+        failures += 1
+        print("check_trace: " + message)
+
+
+def check_dump(path):
+    with open(path) as dump:
+        lines = dump.readlines()
+    parts = [line for line in lines if line.startswith("parts,")]
+    parts = int(parts[0].split(",")[1])
+
+    output = subprocess.run([sys.executable, DECODER, path], check=True,
+        capture_output=True, text=True).stdout
+    names = []
+    times = []
+    for line in output.splitlines():
+        match = LINE.match(line)
+        check(match is not None, "can't read the line %r" % line)
+        if match:
+            times.append(float(match.group(1)))
+            names.append(match.group(3))
+
+    check(names == ORDER * parts,
+        "expected %d parts of %s, got %s" % (parts, ORDER, names))
+    check(times == sorted(times), "time went back: %s" % times)
+
+
+def check_decoder():
+    def times(dump):
+        lines = ["ast-begin,%d,0" % len(dump)]
+        lines += ["ast,%d,6,0" % time for time in dump]
+        return [time for time, _, _ in read_events(lines)]
+
+    # an interrupt recorded 30 us early is not a wrap
+    check(times([1000, 2000, 1970, 3000]) == [1000, 2000, 1970, 3000],
+        "a small step back was taken as a wrap")
+    # the clock wraps, with an early event on either side of it
+    top = (1 << 32) - 100
+    check(times([top, top + 50, 20, top + 90, 200])
+        == [top, top + 50, (1 << 32) + 20, top + 90, (1 << 32) + 200],
+        "the clock wrapping was not unwrapped")
+
+
+def main():
+    check_dump(sys.argv[1])
+    check_decoder()
+    print("check_trace: %s" % ("ok" if failures == 0 else
+        "%d failed" % failures))
+    return 0 if failures == 0 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
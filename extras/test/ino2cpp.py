@@ -0,0 +1,40 @@
+"""
+Turns an Arduino sketch into C++ the way the Arduino IDE does, by adding a
+declaration for every function after the last #include, so functions can be
+used before they are defined. The result is written to stdout.
+  python3 ino2cpp.py Sketch.ino > Sketch.cpp
+"""
+
+import re
+import sys
+
+FUNCTION = re.compile(
+    r'^((?:static\s+)?[A-Za-z_][\w<>:*&\s]*?[\s*&]\w+\s*\([^;{)]*\))\s*\{',
+    re.M)
+KEYWORDS = ('if', 'else', 'for', 'while', 'switch', 'return')
+
+
+def main():
+    with open(sys.argv[1]) as sketch:
+        source = sketch.read()
+
+    declarations = []
+    for match in FUNCTION.finditer(source):
+        signature = match.group(1)
+        if signature.split()[0] not in KEYWORDS:
+            declarations.append(' '.join(signature.split()) + ';')
+
+    lines = source.split('\n')
+    last_include = max(
+        (i for i, line in enumerate(lines) if line.startswith('#include')),
+        default=-1)
+    print('#include <Arduino.h>')
+    print('#line 1 "%s"' % sys.argv[1])
+    print('\n'.join(lines[:last_include + 1]))
+    print('\n'.join(declarations))
+    print('#line %d "%s"' % (last_include + 2, sys.argv[1]))
+    print('\n'.join(lines[last_include + 1:]))
+
+
+if __name__ == '__main__':
+    main()
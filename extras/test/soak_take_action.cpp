@@ -0,0 +1,100 @@
+/**
+ * TakeActionBetweenMessages soak test
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Runs the real TakeActionBetweenMessages sketch, setup and then loop over
+ * and over, against the emulated matrix and clock for 30 simulated days,
+ * and prints a line per day like the SoakTest example does:
+ *   day, messages shown, live messages, peak messages, heap bytes,
+ *   heap high-water mark, drift in milliseconds
+ * The drift is how far the start of the latest message is from the sum of
+ * the time every sequence before it should have played for, so it grows
+ * if the sketch loses time between messages.
+ *
+ * The clock jumps from one event to the next, the next frame or the next
+ * blink of the led, so a day takes a few seconds. At the end the test
+ * checks that the messages and the heap stopped growing after the first
+ * day and that the drift stayed within one scroll step.
+ *
+ *   make soak
+ *   ./build/soak_take_action [days]
+ */
+
+// count the message objects the sketch creates
+#define ASYNC_SCROLLING_MESSAGE_STATS
+
+#include "TakeActionBetweenMessages.cpp"
+
+#include "check.h"
+
+static const unsigned long MILLIS_PER_DAY = 24UL * 60 * 60 * 1000;
+
+// the milliseconds until the sketch has something to do: the next frame of
+// the sequence, or the next blink of the led
+static unsigned long untilNextEvent() {
+  unsigned long now = millis();
+  unsigned long next = previousBlink + blinkInterval - now;
+  if (matrix.isPlaying()) {
+    uint64_t frame = (matrix.getNextChange() - HostEmulator::getMicros()
+      + 999) / 1000;
+    if (frame < next) {
+      next = frame;
+    }
+  }
+  return next > 0 ? next : 1;
+}
+
+int main(int argc, char** argv) {
+  unsigned long days = argc > 1 ? strtoul(argv[1], nullptr, 10) : 30;
+
+  setup();
+
+  unsigned long plays = matrix.getPlays();
+  unsigned long long idealMillis = 0;
+  unsigned long sequenceMillis = 0;
+  long long drift = 0;
+  long long maxDrift = 0;
+  unsigned long long start = HostEmulator::getMicros() / 1000;
+
+  unsigned long liveAfterFirstDay = 0;
+  size_t peakAfterFirstDay = 0;
+
+  printf("day,messages,live,peak,heap,heapPeak,driftMillis\n");
+  for (unsigned long day = 1; day <= days; day++) {
+    unsigned long long end = start + (unsigned long long)day * MILLIS_PER_DAY;
+    while (HostEmulator::getMicros() / 1000 < end) {
+      loop();
+
+      // a new sequence should start exactly when the ones before it have
+      // played for as long as their frames say
+      if (matrix.getPlays() != plays) {
+        plays = matrix.getPlays();
+        idealMillis += sequenceMillis;
+        sequenceMillis = matrix.getSequenceDuration();
+        drift = (long long)(HostEmulator::getMicros() / 1000 - start)
+          - (long long)idealMillis;
+        if (llabs(drift) > maxDrift) {
+          maxDrift = llabs(drift);
+        }
+      }
+      HostEmulator::advance(untilNextEvent());
+    }
+
+    printf("%lu,%lu,%lu,%lu,%zu,%zu,%lld\n", day, plays,
+      AsyncScrollingStats::getLiveMessages(),
+      AsyncScrollingStats::getPeakMessages(), HostHeap::getLiveBytes(),
+      HostHeap::getPeakBytes(), drift);
+    if (day == 1) {
+      liveAfterFirstDay = AsyncScrollingStats::getLiveMessages();
+      peakAfterFirstDay = HostHeap::getPeakBytes();
+    }
+  }
+
+  CHECK(plays > days);
+  CHECK_EQUAL(liveAfterFirstDay, AsyncScrollingStats::getLiveMessages());
+  // the heap changes with the text the matrix holds for the last message
+  // drawn, but never goes above what it reached on the first day
+  CHECK_EQUAL(peakAfterFirstDay, HostHeap::getPeakBytes());
+  CHECK(maxDrift <= 60);
+  return checkResult("soak_take_action");
+}
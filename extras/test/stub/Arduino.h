@@ -0,0 +1,302 @@
+/**
+ * Arduino core stand-in for the host tests
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Just enough of the Arduino core for the library to compile and run on a
+ * computer: String, Print, Stream, Serial, the flash string helpers and the
+ * time functions. millis, micros and delay follow the emulator clock in
+ * HostEmulator.h, so time only moves when a test moves it.
+ */
+
+#ifndef _HOST_ARDUINO_H_
+#define _HOST_ARDUINO_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <utility>
+
+#include "HostEmulator.h"
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define LED_BUILTIN 13
+
+typedef int PinStatus;
+typedef void (*voidFuncPtr)(void);
+
+template <class T, class L>
+auto min(const T& a, const L& b) -> decltype((b < a) ? b : a) {
+  return (b < a) ? b : a;
+}
+
+template <class T, class L>
+auto max(const T& a, const L& b) -> decltype((b < a) ? b : a) {
+  return (a < b) ? b : a;
+}
+
+// the UNO R4 reads flash like RAM, and so does the host. a flash string is
+// still its own type so the F() overloads are picked
+#define PROGMEM
+#define pgm_read_byte(address) (*(const unsigned char*)(address))
+#define strlen_P strlen
+class __FlashStringHelper;
+#define F(text) (reinterpret_cast<const __FlashStringHelper*>(text))
+#define FPSTR(text) (reinterpret_cast<const __FlashStringHelper*>(text))
+
+inline void pinMode(int, int) {
+}
+
+inline void digitalWrite(int, int) {
+}
+
+inline unsigned long millis() {
+  return (unsigned long)(HostEmulator::getMicros() / 1000);
+}
+
+inline unsigned long micros() {
+  return (unsigned long)HostEmulator::getMicros();
+}
+
+inline void delay(unsigned long milliseconds) {
+  HostEmulator::advance(milliseconds);
+}
+
+// interrupts are emulated by the code that moves the clock, which never
+// runs while the sketch is in the middle of something, so these only count
+// how deep the sketch is in a section with interrupts off
+inline void noInterrupts() {
+  HostEmulator::setInterruptsOff(true);
+}
+
+inline void interrupts() {
+  HostEmulator::setInterruptsOff(false);
+}
+
+class String {
+public:
+
+  // like the Arduino core, a null text makes an empty String without a
+  // buffer, while any other text, even "", is copied into a new one
+  String(const char* text = "")
+    : buffer(nullptr),
+      size(0) {
+    if (text != nullptr) {
+      assign(text, strlen(text));
+    }
+  }
+
+  String(const __FlashStringHelper* text)
+    : String(reinterpret_cast<const char*>(text)) {
+  }
+
+  String(const String& other) {
+    assign(other.buffer, other.size);
+  }
+
+  String(String&& other)
+    : buffer(other.buffer),
+      size(other.size) {
+    other.buffer = nullptr;
+    other.size = 0;
+  }
+
+  ~String() {
+    free(buffer);
+  }
+
+  String& operator=(const String& other) {
+    if (this != &other) {
+      free(buffer);
+      assign(other.buffer, other.size);
+    }
+    return *this;
+  }
+
+  String& operator=(String&& other) {
+    std::swap(buffer, other.buffer);
+    std::swap(size, other.size);
+    return *this;
+  }
+
+  String& operator+=(char c) {
+    char* grown = static_cast<char*>(realloc(buffer, size + 2));
+    if (grown != nullptr) {
+      buffer = grown;
+      buffer[size++] = c;
+      buffer[size] = 0;
+    }
+    return *this;
+  }
+
+  bool concat(char c) {
+    *this += c;
+    return true;
+  }
+
+  bool reserve(unsigned int) {
+    return true;
+  }
+
+  unsigned int length() const {
+    return size;
+  }
+
+  const char* c_str() const {
+    return buffer != nullptr ? buffer : "";
+  }
+
+  char charAt(unsigned int i) const {
+    return i < size ? buffer[i] : 0;
+  }
+
+  char operator[](unsigned int i) const {
+    return charAt(i);
+  }
+
+  String substring(unsigned int start, unsigned int end) const {
+    String part(nullptr, 0);
+    part.assign(buffer + start, end - start);
+    return part;
+  }
+
+  bool operator==(const char* text) const {
+    return strcmp(c_str(), text) == 0;
+  }
+
+private:
+
+  String(std::nullptr_t, int)
+    : buffer(nullptr),
+      size(0) {
+  }
+
+  void assign(const char* text, size_t length) {
+    buffer = static_cast<char*>(malloc(length + 1));
+    if (length > 0) {
+      memcpy(buffer, text, length);
+    }
+    buffer[length] = 0;
+    size = length;
+  }
+
+  char* buffer;
+  unsigned int size;
+};
+
+class Print {
+public:
+
+  virtual ~Print() {
+  }
+
+  virtual size_t write(uint8_t c) = 0;
+
+  virtual size_t write(const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+      write(data[i]);
+    }
+    return length;
+  }
+
+  size_t write(const char* text) {
+    return write(reinterpret_cast<const uint8_t*>(text), strlen(text));
+  }
+
+  size_t print(const String& text) {
+    return write(text.c_str());
+  }
+
+  size_t print(const char* text) {
+    return write(text);
+  }
+
+  size_t print(const __FlashStringHelper* text) {
+    return write(reinterpret_cast<const char*>(text));
+  }
+
+  size_t print(char c) {
+    return write((uint8_t)c);
+  }
+
+  size_t print(unsigned long value, int = 10) {
+    char text[24];
+    snprintf(text, sizeof(text), "%lu", value);
+    return write(text);
+  }
+
+  size_t print(long value, int = 10) {
+    char text[24];
+    snprintf(text, sizeof(text), "%ld", value);
+    return write(text);
+  }
+
+  size_t print(unsigned int value, int base = 10) {
+    return print((unsigned long)value, base);
+  }
+
+  size_t print(int value, int base = 10) {
+    return print((long)value, base);
+  }
+
+  size_t print(double value, int digits = 2) {
+    char text[32];
+    snprintf(text, sizeof(text), "%.*f", digits, value);
+    return write(text);
+  }
+
+  size_t println() {
+    return write("\n");
+  }
+
+  template <typename T>
+  size_t println(const T& value) {
+    size_t written = print(value);
+    return written + println();
+  }
+};
+
+class Stream : public Print {
+public:
+
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+};
+
+// writes to stdout, and never has anything to read
+class HostSerial : public Stream {
+public:
+
+  void begin(unsigned long) {
+  }
+
+  operator bool() const {
+    return true;
+  }
+
+  size_t write(uint8_t c) override {
+    return fputc(c, stdout) == EOF ? 0 : 1;
+  }
+
+  int available() override {
+    return 0;
+  }
+
+  int read() override {
+    return -1;
+  }
+
+  int peek() override {
+    return -1;
+  }
+};
+
+extern HostSerial Serial;
+
+#endif
@@ -0,0 +1,125 @@
+/**
+ * ArduinoGraphics stand-in for the host tests
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Draws and scrolls text the way ArduinoGraphics does: print collects the
+ * text, and endText draws it once, or for SCROLL_LEFT once for every column
+ * it moves, from the x given to beginText until the last column has left
+ * the screen. Every drawing is passed to endDraw, which the matrix
+ * overrides.
+ */
+
+#ifndef _HOST_ARDUINO_GRAPHICS_H_
+#define _HOST_ARDUINO_GRAPHICS_H_
+
+#include "Arduino.h"
+#include "Font.h"
+
+#define NO_SCROLL 0
+#define SCROLL_LEFT 1
+
+class ArduinoGraphics : public Print {
+public:
+
+  ArduinoGraphics(int width, int height)
+    : graphicsWidth(width),
+      graphicsHeight(height),
+      font(nullptr),
+      textX(0),
+      textY(0),
+      scrollSpeed(150) {
+  }
+
+  int width() {
+    return graphicsWidth;
+  }
+
+  int height() {
+    return graphicsHeight;
+  }
+
+  virtual void beginDraw() {
+  }
+
+  virtual void endDraw() {
+  }
+
+  virtual void clear() {
+  }
+
+  // set one pixel, only on or off is emulated
+  virtual void set(int x, int y, uint8_t r, uint8_t g, uint8_t b) = 0;
+
+  void stroke(uint32_t) {
+  }
+
+  void textFont(const Font& font) {
+    this->font = &font;
+  }
+
+  void textScrollSpeed(unsigned long speed) {
+    scrollSpeed = speed;
+  }
+
+  void beginText(int x = 0, int y = 0, uint32_t = 0xFFFFFF) {
+    textX = x;
+    textY = y;
+    text = String();
+  }
+
+  void endText(int scrollDirection = NO_SCROLL) {
+    if (scrollDirection == SCROLL_LEFT && font != nullptr) {
+      int scrollLength = (int)text.length() * font->width + textX;
+      for (int i = 0; i < scrollLength; i++) {
+        beginDraw();
+        drawText(textX - i, textY);
+        endDraw();
+      }
+    } else {
+      beginDraw();
+      drawText(textX, textY);
+      endDraw();
+    }
+  }
+
+  size_t write(uint8_t c) override {
+    text += (char)c;
+    return 1;
+  }
+
+protected:
+
+  // draw the collected text with its first column at x, clipped to the
+  // screen. glyph rows are drawn from the top, highest bit on the left
+  void drawText(int x, int y) {
+    if (font == nullptr) {
+      return;
+    }
+    for (unsigned int i = 0; i < text.length(); i++) {
+      const uint8_t* glyph = font->data[(uint8_t)text[i]];
+      if (glyph == nullptr) {
+        glyph = font->data[(uint8_t)' '];
+      }
+      for (int row = 0; glyph != nullptr && row < font->height; row++) {
+        for (int column = 0; column < font->width; column++) {
+          int px = x + (int)i * font->width + column;
+          int py = y + row;
+          if (px >= 0 && px < graphicsWidth && py >= 0 && py < graphicsHeight
+            && (glyph[row] & (0x80 >> column))) {
+            set(px, py, 0xFF, 0xFF, 0xFF);
+          }
+        }
+      }
+    }
+  }
+
+  int graphicsWidth;
+  int graphicsHeight;
+  const Font* font;
+  int textX;
+  int textY;
+  unsigned long scrollSpeed;
+  String text;
+};
+
+#endif
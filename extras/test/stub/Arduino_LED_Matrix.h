@@ -0,0 +1,280 @@
+/**
+ * Arduino_LED_Matrix stand-in for the host tests
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Emulates the 12 by 8 matrix of the UNO R4. Frames are three uint32_t,
+ * row by row, starting with the highest bit. A sequence loaded with
+ * loadWrapper or loadTextAnimationSequence plays on the emulator clock,
+ * every frame for the milliseconds in its fourth word. The callback is
+ * called as soon as the last frame of a sequence is shown, which is when
+ * the board calls it.
+ *
+ * endTextAnimation draws every step of the scroll, like the board, but only
+ * keeps as many frames as the buffer has room for. getCapturedFrames tells
+ * how many were drawn, so a test can see when frames were cut off.
+ */
+
+#ifndef _HOST_ARDUINO_LED_MATRIX_H_
+#define _HOST_ARDUINO_LED_MATRIX_H_
+
+#include "ArduinoGraphics.h"
+#include "TextAnimation.h"
+
+class ArduinoLEDMatrix : public ArduinoGraphics {
+public:
+
+  ArduinoLEDMatrix()
+    : ArduinoGraphics(12, 8),
+      sequence(nullptr),
+      sequenceLength(0),
+      sequenceIndex(0),
+      nextChange(0),
+      playing(false),
+      looping(false),
+      callback(nullptr),
+      capture(nullptr),
+      captured(0),
+      plays(0),
+      framesShown(0),
+      frameLoads(0),
+      callbacks(0) {
+    clearFrame(canvas);
+    clearFrame(frame);
+    HostEmulator::attach(this);
+  }
+
+  ~ArduinoLEDMatrix() {
+    HostEmulator::detach(this);
+  }
+
+  ArduinoLEDMatrix(const ArduinoLEDMatrix&) = delete;
+  ArduinoLEDMatrix& operator=(const ArduinoLEDMatrix&) = delete;
+
+  int begin() {
+    return 1;
+  }
+
+  void beginDraw() override {
+    clearFrame(canvas);
+  }
+
+  void endDraw() override {
+    if (capture == nullptr) {
+      loadFrame(canvas);
+      return;
+    }
+    if (captured < capture[0][0]) {
+      uint32_t* target = capture[1 + captured];
+      target[0] = canvas[0];
+      target[1] = canvas[1];
+      target[2] = canvas[2];
+      target[3] = scrollSpeed;
+    }
+    captured++;
+  }
+
+  void clear() override {
+    clearFrame(canvas);
+  }
+
+  void set(int x, int y, uint8_t r, uint8_t g, uint8_t b) override {
+    size_t bit = y * 12 + x;
+    uint32_t mask = 0x80000000UL >> (bit % 32);
+    if (r || g || b) {
+      canvas[bit / 32] |= mask;
+    } else {
+      canvas[bit / 32] &= ~mask;
+    }
+  }
+
+  void setCallback(voidFuncPtr callback) {
+    this->callback = callback;
+  }
+
+  /**
+   * Show a frame right away. A sequence that was playing stops without
+   * calling the callback.
+   */
+  void loadFrame(const uint32_t buffer[3]) {
+    playing = false;
+    frameLoads++;
+    show(buffer);
+  }
+
+  void loadWrapper(const uint32_t buffer[][4], uint32_t bytes) {
+    sequence = buffer;
+    sequenceLength = bytes / sizeof(buffer[0]);
+    sequenceIndex = 0;
+    playing = false;
+  }
+
+  void endTextAnimation(int scrollDirection, uint32_t buffer[][4]) {
+    capture = buffer;
+    captured = 0;
+    endText(scrollDirection);
+    uint32_t kept = captured < buffer[0][0] ? captured : buffer[0][0];
+    buffer[0][1] = kept * sizeof(buffer[0]);
+    capture = nullptr;
+  }
+
+  void loadTextAnimationSequence(uint32_t buffer[][4]) {
+    loadWrapper(&buffer[1], buffer[0][1]);
+  }
+
+  void play(bool loop = false) {
+    if (sequenceLength == 0) {
+      return;
+    }
+    looping = loop;
+    sequenceIndex = 0;
+    playing = true;
+    plays++;
+    nextChange = HostEmulator::getMicros();
+    showNext();
+  }
+
+  bool sequenceDone() {
+    return !playing;
+  }
+
+  // the rest is only in the emulator
+
+  /**
+   * The frame on the screen
+   */
+  const uint32_t* getFrame() const {
+    return frame;
+  }
+
+  /**
+   * The number of frames drawn by the last endTextAnimation, including the
+   * ones that did not fit in the buffer
+   */
+  size_t getCapturedFrames() const {
+    return captured;
+  }
+
+  /**
+   * The number of frames in the loaded sequence
+   */
+  size_t getSequenceLength() const {
+    return sequenceLength;
+  }
+
+  bool isPlaying() const {
+    return playing;
+  }
+
+  /**
+   * The number of times a sequence was started with play
+   */
+  unsigned long getPlays() const {
+    return plays;
+  }
+
+  /**
+   * The milliseconds from play until the callback of the loaded sequence,
+   * every frame's duration but the last one's, since the callback is called
+   * when the last frame appears
+   */
+  unsigned long getSequenceDuration() const {
+    unsigned long duration = 0;
+    for (size_t i = 0; i + 1 < sequenceLength; i++) {
+      duration += sequence[i][3];
+    }
+    return duration;
+  }
+
+  /**
+   * The number of times the screen changed, by a sequence or loadFrame
+   */
+  unsigned long getFramesShown() const {
+    return framesShown;
+  }
+
+  /**
+   * The number of calls to loadFrame
+   */
+  unsigned long getFrameLoads() const {
+    return frameLoads;
+  }
+
+  /**
+   * The number of times the callback was called
+   */
+  unsigned long getCallbacks() const {
+    return callbacks;
+  }
+
+  /**
+   * When the timer of a playing sequence is due next, in emulator
+   * microseconds
+   */
+  uint64_t getNextChange() const {
+    return nextChange;
+  }
+
+  /**
+   * Called by the emulator when the timer is due
+   */
+  void runTimer() {
+    if (playing) {
+      showNext();
+    }
+  }
+
+private:
+
+  static void clearFrame(uint32_t target[3]) {
+    target[0] = 0;
+    target[1] = 0;
+    target[2] = 0;
+  }
+
+  void show(const uint32_t buffer[3]) {
+    frame[0] = buffer[0];
+    frame[1] = buffer[1];
+    frame[2] = buffer[2];
+    framesShown++;
+  }
+
+  // show the frame at sequenceIndex and schedule the one after it.
+  // sequenceIndex is the frame that is shown next. the callback is called
+  // when the last frame appears
+  void showNext() {
+    const uint32_t* current = sequence[sequenceIndex];
+    show(current);
+    nextChange += (uint64_t)current[3] * 1000;
+    if (sequenceIndex + 1 < sequenceLength) {
+      sequenceIndex++;
+      return;
+    }
+    if (looping) {
+      sequenceIndex = 0;
+      return;
+    }
+    playing = false;
+    callbacks++;
+    if (callback != nullptr) {
+      callback();
+    }
+  }
+
+  uint32_t canvas[3];
+  uint32_t frame[3];
+  const uint32_t (*sequence)[4];
+  size_t sequenceLength;
+  size_t sequenceIndex;
+  uint64_t nextChange;
+  bool playing;
+  bool looping;
+  voidFuncPtr callback;
+  uint32_t (*capture)[4];
+  uint32_t captured;
+  unsigned long plays;
+  unsigned long framesShown;
+  unsigned long frameLoads;
+  unsigned long callbacks;
+};
+
+#endif
@@ -0,0 +1,25 @@
+/**
+ * ArduinoGraphics fonts for the host tests
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * The same layout as the ArduinoGraphics Font struct: one glyph per
+ * character, one byte per row, with the leftmost column in the highest bit.
+ * The host fonts have made up glyphs that are different for every
+ * character, so a column that ends up in the wrong place is noticed.
+ */
+
+#ifndef _HOST_FONT_H_
+#define _HOST_FONT_H_
+
+#include <stdint.h>
+
+struct Font {
+  int width;
+  int height;
+  const uint8_t* data[256];
+};
+
+extern const struct Font Font_4x6;
+extern const struct Font Font_5x7;
+
+#endif
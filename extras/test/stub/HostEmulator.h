@@ -0,0 +1,84 @@
+/**
+ * HostEmulator
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * The emulator clock and heap counters behind the host stand-ins for the
+ * Arduino libraries. The clock only moves when a test calls advance, or when
+ * the sketch calls delay. While it moves, every emulated matrix that is
+ * playing a sequence shows its frames at the times the board would, and
+ * calls its callback from inside advance, the way the board calls it from
+ * its timer interrupt.
+ *
+ * The heap counters see every malloc, realloc and free made by the tests
+ * and the library, including operator new, so a test can check how many
+ * allocations something makes and how many bytes stay in use.
+ */
+
+#ifndef _HOST_EMULATOR_H_
+#define _HOST_EMULATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+class ArduinoLEDMatrix;
+
+namespace HostEmulator {
+
+  /**
+   * The emulator time in microseconds since the test started
+   */
+  uint64_t getMicros();
+
+  /**
+   * Move the clock forward, playing the frames and calling the callbacks of
+   * every matrix that are due on the way, in order
+   */
+  void advance(unsigned long milliseconds);
+  void advanceMicros(uint64_t microseconds);
+
+  /**
+   * Called between two points in time whenever the clock moves, for example
+   * to model an interrupt. Pass nullptr to remove it.
+   */
+  typedef void (*Hook)();
+  void setTimerHook(Hook hook);
+
+  /**
+   * Used by noInterrupts and interrupts. The timer hook is not called and
+   * matrix callbacks wait while interrupts are off, like on the board.
+   */
+  void setInterruptsOff(bool off);
+  bool areInterruptsOff();
+
+  // the matrices register themselves so advance can play their sequences
+  void attach(ArduinoLEDMatrix* matrix);
+  void detach(ArduinoLEDMatrix* matrix);
+}
+
+namespace HostHeap {
+
+  /**
+   * The number of allocations made so far, reallocations included
+   */
+  unsigned long getAllocations();
+
+  /**
+   * The bytes asked for by every allocation made so far
+   */
+  unsigned long long getRequestedBytes();
+
+  /**
+   * The bytes that are allocated right now
+   */
+  size_t getLiveBytes();
+
+  /**
+   * The most bytes that were allocated at the same time since the last
+   * call to resetPeak
+   */
+  size_t getPeakBytes();
+
+  void resetPeak();
+}
+
+#endif
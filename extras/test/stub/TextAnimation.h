@@ -0,0 +1,19 @@
+/**
+ * TextAnimation stand-in for the host tests
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Like the matrix library, the first row of an animation buffer is kept for
+ * the matrix itself. It holds the number of frames the buffer has room for,
+ * so capturing stops at the end of the buffer, and the size in bytes of the
+ * frames that were captured.
+ */
+
+#ifndef _HOST_TEXT_ANIMATION_H_
+#define _HOST_TEXT_ANIMATION_H_
+
+#include <stdint.h>
+
+#define TEXT_ANIMATION_DEFINE(name, max) \
+  uint32_t name[(max) + 1][4] = { { (max), 0, 0, 0 } };
+
+#endif
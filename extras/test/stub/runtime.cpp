@@ -0,0 +1,255 @@
+/**
+ * The parts of the host stand-ins that are not in the headers: Serial, the
+ * fonts, the emulator clock and the heap counters.
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * The heap counters need the test to be linked with
+ *   -Wl,--wrap=malloc -Wl,--wrap=calloc -Wl,--wrap=realloc -Wl,--wrap=free
+ * which the Makefile does.
+ */
+
+#include <malloc.h>
+
+#include <new>
+
+#include "Arduino.h"
+#include "Arduino_LED_Matrix.h"
+
+HostSerial Serial;
+
+// made up glyphs, different for every character and every row. space is
+// blank like in a real font
+struct HostFont {
+  HostFont(int width, int height)
+    : font() {
+    font.width = width;
+    font.height = height;
+    uint8_t mask = (uint8_t)(0xFF << (8 - width));
+    for (int c = ' '; c <= '~'; c++) {
+      for (int row = 0; row < height; row++) {
+        uint32_t hash = (uint32_t)(c * 2654435761UL) ^ (uint32_t)(row * 40503);
+        hash ^= hash >> 13;
+        glyphs[c][row] = c == ' ' ? 0 : (uint8_t)(hash >> 5) & mask;
+      }
+      font.data[c] = glyphs[c];
+    }
+  }
+
+  Font font;
+  uint8_t glyphs[128][8];
+};
+
+static const HostFont hostFont4x6(4, 6);
+static const HostFont hostFont5x7(5, 7);
+
+const Font Font_4x6 = hostFont4x6.font;
+const Font Font_5x7 = hostFont5x7.font;
+
+namespace {
+
+  const size_t MAX_MATRICES = 8;
+
+  struct Emulator {
+    uint64_t micros;
+    ArduinoLEDMatrix* matrices[MAX_MATRICES];
+    HostEmulator::Hook hook;
+    bool interruptsOff;
+  };
+
+  Emulator& emulator() {
+    static Emulator state = {};
+    return state;
+  }
+
+  struct Heap {
+    unsigned long allocations;
+    unsigned long long requested;
+    size_t live;
+    size_t peak;
+  };
+
+  Heap heap = {};
+
+  void allocated(void* pointer, size_t requested) {
+    if (pointer == nullptr) {
+      return;
+    }
+    heap.allocations++;
+    heap.requested += requested;
+    heap.live += malloc_usable_size(pointer);
+    if (heap.live > heap.peak) {
+      heap.peak = heap.live;
+    }
+  }
+
+  void freed(void* pointer) {
+    if (pointer != nullptr) {
+      heap.live -= malloc_usable_size(pointer);
+    }
+  }
+}
+
+uint64_t HostEmulator::getMicros() {
+  return emulator().micros;
+}
+
+void HostEmulator::advance(unsigned long milliseconds) {
+  advanceMicros((uint64_t)milliseconds * 1000);
+}
+
+void HostEmulator::advanceMicros(uint64_t microseconds) {
+  Emulator& state = emulator();
+  uint64_t target = state.micros + microseconds;
+
+  // run the matrix timers that are due before target, earliest first, so
+  // callbacks see the time they would be called at on the board
+  while (!state.interruptsOff) {
+    ArduinoLEDMatrix* due = nullptr;
+    for (size_t i = 0; i < MAX_MATRICES; i++) {
+      ArduinoLEDMatrix* matrix = state.matrices[i];
+      if (matrix != nullptr && matrix->isPlaying()
+        && matrix->getNextChange() <= target
+        && (due == nullptr || matrix->getNextChange() < due->getNextChange())) {
+        due = matrix;
+      }
+    }
+    if (due == nullptr) {
+      break;
+    }
+    if (due->getNextChange() > state.micros) {
+      state.micros = due->getNextChange();
+    }
+    due->runTimer();
+  }
+
+  state.micros = target;
+  if (state.hook != nullptr && !state.interruptsOff) {
+    state.hook();
+  }
+}
+
+void HostEmulator::setTimerHook(Hook hook) {
+  emulator().hook = hook;
+}
+
+void HostEmulator::setInterruptsOff(bool off) {
+  emulator().interruptsOff = off;
+}
+
+bool HostEmulator::areInterruptsOff() {
+  return emulator().interruptsOff;
+}
+
+void HostEmulator::attach(ArduinoLEDMatrix* matrix) {
+  Emulator& state = emulator();
+  for (size_t i = 0; i < MAX_MATRICES; i++) {
+    if (state.matrices[i] == nullptr) {
+      state.matrices[i] = matrix;
+      return;
+    }
+  }
+  fprintf(stderr, "more than %zu emulated matrices\n", MAX_MATRICES);
+  abort();
+}
+
+void HostEmulator::detach(ArduinoLEDMatrix* matrix) {
+  Emulator& state = emulator();
+  for (size_t i = 0; i < MAX_MATRICES; i++) {
+    if (state.matrices[i] == matrix) {
+      state.matrices[i] = nullptr;
+    }
+  }
+}
+
+unsigned long HostHeap::getAllocations() {
+  return heap.allocations;
+}
+
+unsigned long long HostHeap::getRequestedBytes() {
+  return heap.requested;
+}
+
+size_t HostHeap::getLiveBytes() {
+  return heap.live;
+}
+
+size_t HostHeap::getPeakBytes() {
+  return heap.peak;
+}
+
+void HostHeap::resetPeak() {
+  heap.peak = heap.live;
+}
+
+extern "C" {
+
+  void* __real_malloc(size_t size);
+  void* __real_calloc(size_t count, size_t size);
+  void* __real_realloc(void* pointer, size_t size);
+  void __real_free(void* pointer);
+
+  void* __wrap_malloc(size_t size) {
+    void* pointer = __real_malloc(size);
+    allocated(pointer, size);
+    return pointer;
+  }
+
+  void* __wrap_calloc(size_t count, size_t size) {
+    void* pointer = __real_calloc(count, size);
+    allocated(pointer, count * size);
+    return pointer;
+  }
+
+  void* __wrap_realloc(void* pointer, size_t size) {
+    size_t before = pointer != nullptr ? malloc_usable_size(pointer) : 0;
+    void* moved = __real_realloc(pointer, size);
+    if (moved != nullptr) {
+      heap.live -= before;
+      allocated(moved, size);
+    }
+    return moved;
+  }
+
+  void __wrap_free(void* pointer) {
+    freed(pointer);
+    __real_free(pointer);
+  }
+}
+
+// operator new goes through malloc so it is counted too
+
+void* operator new(size_t size) {
+  void* pointer = malloc(size > 0 ? size : 1);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return malloc(size > 0 ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return malloc(size > 0 ? size : 1);
+}
+
+void operator delete(void* pointer) noexcept {
+  free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+  free(pointer);
+}
@@ -0,0 +1,74 @@
+/**
+ * Animation buffer capacity test
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Plays messages split for animation buffers of several sizes on the
+ * emulated matrix. Every part but the last one has to fill its buffer to
+ * the last frame, the matrix has to play exactly getFrameCount frames of
+ * every part, and the scroll has to have drawn at least that many, since
+ * the matrix drops the frames that don't fit in the buffer.
+ */
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include "AsyncScrollingChain.hpp"
+#include "AsyncScrollingPlayer.hpp"
+#include "check.h"
+
+TEXT_ANIMATION_DEFINE(small, 13)
+TEXT_ANIMATION_DEFINE(medium, 61)
+TEXT_ANIMATION_DEFINE(large, 241)
+
+static const char text[] =
+  "   the quick brown fox jumps over the lazy dog, then it does it again and"
+  " again, until the dog wakes up and chases it all the way home";
+
+static void testBuffer(
+  ArduinoLEDMatrix& matrix, AsyncScrollingFrames frames, size_t length,
+  const Font& font) {
+  AsyncScrollingPlayer player(matrix, frames);
+  AsyncScrollingChain chain(AsyncScrollingMessage::generateMessages(
+    String(text).substring(0, length), matrix, frames, font));
+  CHECK(!chain.isEmpty());
+
+  size_t total = 0;
+  for (AsyncScrollingMessage* m = chain.getFirst(); m != nullptr;
+    m = m->getNext()) {
+    player.show(m);
+    if (m->hasContinuation()) {
+      // the matrix dropped the frames that did not fit
+      CHECK_EQUAL(frames.getCapacity(), m->getFrameCount());
+      CHECK(matrix.getCapturedFrames() > m->getFrameCount());
+    } else if (m->getWidth() > (size_t)matrix.width()) {
+      CHECK(m->getFrameCount() <= frames.getCapacity());
+    }
+    if (m->getWidth() > (size_t)matrix.width() || m->hasContinuation()
+      || m->isContinuation()) {
+      CHECK_EQUAL(m->getFrameCount(), matrix.getSequenceLength());
+      CHECK(matrix.getCapturedFrames() >= m->getFrameCount());
+    }
+    total += m->getFrameCount();
+    HostEmulator::advance(m->getDuration(60) + 60);
+  }
+
+  // the parts together play the whole scroll, each column once
+  if (chain.getFirst()->hasContinuation()) {
+    CHECK_EQUAL(length * font.width, total);
+  }
+}
+
+int main() {
+  ArduinoLEDMatrix matrix;
+  matrix.textScrollSpeed(60);
+
+  const Font* fonts[] = { &Font_4x6, &Font_5x7 };
+  for (const Font* font : fonts) {
+    for (size_t length = 1; length < sizeof(text); length += 7) {
+      testBuffer(matrix, small, length, *font);
+      testBuffer(matrix, medium, length, *font);
+      testBuffer(matrix, large, length, *font);
+    }
+  }
+  return checkResult("test_capacity");
+}
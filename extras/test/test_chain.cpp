@@ -0,0 +1,195 @@
+/**
+ * AsyncScrollingChain leak test
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Runs a random workload of building chains, splicing them into each other
+ * and into playlists, playing them on the emulated matrix, and clearing or
+ * destroying them part way through a message. Built with AddressSanitizer
+ * by the Makefile, so a message that is freed twice or used after it was
+ * freed stops the test, and one that is never freed is reported as a leak
+ * when it ends. The message and heap counters are checked as well.
+ *
+ *   make build/test_chain && ./build/test_chain [iterations] [seed]
+ */
+
+#define ASYNC_SCROLLING_MESSAGE_STATS
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include <random>
+
+#include "AsyncScrollingChain.hpp"
+#include "AsyncScrollingPlayer.hpp"
+#include "AsyncScrollingPlaylist.hpp"
+#include "check.h"
+
+TEXT_ANIMATION_DEFINE(anim, 40)
+
+static const char text[] =
+  "   the quick brown fox jumps over the lazy dog again and again";
+
+static const size_t CHAINS = 8;
+
+// the number of messages from first to the end of the list
+static size_t countLinks(AsyncScrollingMessage* first) {
+  size_t count = 0;
+  for (AsyncScrollingMessage* m = first; m != nullptr; m = m->getNext()) {
+    count++;
+  }
+  return count;
+}
+
+// a chain that leads into a playlist is deleted up to the playlist, whose
+// links are left alone
+static void testIntoPlaylist(ArduinoLEDMatrix& matrix) {
+  AsyncScrollingPlaylistItem items[] = {
+    { "   first item of the playlist, long enough to continue", &Font_5x7 },
+    { "   second item", &Font_4x6 }
+  };
+  AsyncScrollingPlaylist playlist(items, 2, matrix, anim);
+  unsigned long live = AsyncScrollingStats::getLiveMessages();
+  {
+    AsyncScrollingChain chain(AsyncScrollingMessage::generateMessages(
+      "   before the playlist, long enough to continue", matrix, anim,
+      Font_5x7));
+    chain.getLast()->setNext(playlist.getFirst());
+  }
+  CHECK_EQUAL(live, AsyncScrollingStats::getLiveMessages());
+  CHECK_EQUAL(playlist.getMessageCount(), countLinks(playlist.getFirst()));
+
+  // a chain whose first message is in the playlist deletes nothing
+  {
+    AsyncScrollingChain chain(playlist.getFirst()->getNext());
+  }
+  CHECK_EQUAL(live, AsyncScrollingStats::getLiveMessages());
+  CHECK_EQUAL(playlist.getMessageCount(), countLinks(playlist.getFirst()));
+}
+
+// a chain that loops back to any of its messages is deleted once around,
+// and its last message is the one that links back
+static void testLoops(ArduinoLEDMatrix& matrix) {
+  unsigned long live = AsyncScrollingStats::getLiveMessages();
+  for (size_t length = 1; length <= 6; length++) {
+    for (size_t target = 0; target < length; target++) {
+      AsyncScrollingMessage* messages[6];
+      AsyncScrollingChain chain;
+      for (size_t i = 0; i < length; i++) {
+        messages[i] = new AsyncScrollingMessage("   loop", matrix, Font_5x7);
+        chain.append(AsyncScrollingChain(messages[i]));
+      }
+      messages[length - 1]->setNext(messages[target]);
+      CHECK(chain.getLast() == messages[length - 1]);
+      if (target % 2 == 1) {
+        chain.append(AsyncScrollingChain(
+          new AsyncScrollingMessage("   appended", matrix, Font_5x7)));
+        CHECK(messages[length - 1]->getNext() == chain.getLast());
+      }
+      chain.clear();
+      CHECK_EQUAL(live, AsyncScrollingStats::getLiveMessages());
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  unsigned long iterations =
+    argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+  unsigned long seed = argc > 2 ? strtoul(argv[2], nullptr, 10) : 1;
+
+  std::mt19937 random(seed);
+  size_t heapBefore = HostHeap::getLiveBytes();
+  unsigned long liveBefore = AsyncScrollingStats::getLiveMessages();
+  {
+    ArduinoLEDMatrix matrix;
+    matrix.textScrollSpeed(60);
+    AsyncScrollingPlayer player(matrix, anim);
+    AsyncScrollingPlaylistItem items[] = {
+      { "   pool one", &Font_5x7 },
+      { "   pool two that is a lot longer than the first one, much longer",
+        &Font_4x6 }
+    };
+    AsyncScrollingPlaylist playlist(items, 2, matrix, anim);
+    CHECK(playlist.getMessageCount() > 2);
+
+    testIntoPlaylist(matrix);
+    testLoops(matrix);
+
+    AsyncScrollingChain chains[CHAINS];
+    unsigned long played = 0;
+    for (unsigned long i = 0; i < iterations; i++) {
+      AsyncScrollingChain& chain = chains[random() % CHAINS];
+      AsyncScrollingChain& other = chains[random() % CHAINS];
+      switch (random() % 8) {
+      case 0:
+        chain.append(AsyncScrollingChain(AsyncScrollingMessage::generateMessages(
+          String(text).substring(0, random() % sizeof(text)), matrix, anim,
+          random() % 2 ? Font_5x7 : Font_4x6)));
+        break;
+      case 1:
+        chain.append(AsyncScrollingChain(
+          new AsyncScrollingMessage(":)", matrix, Font_5x7)));
+        break;
+      case 2:
+        if (!chain.isEmpty()) {
+          chain.insertAfter(chain.getFirst(), std::move(other));
+        }
+        break;
+      case 3:
+        chain = std::move(other);
+        break;
+      case 4:
+        chain.clear();
+        break;
+      case 5:
+        // start playing, then let the chain go while its frames are still
+        // on the screen
+        if (!chain.isEmpty()) {
+          player.show(chain.getFirst());
+          HostEmulator::advance(random() % 200);
+          played++;
+        }
+        break;
+      case 6:
+        // a chain that ends in the playlist, destroyed before it is done
+        if (i % 64 == 0) {
+          AsyncScrollingChain mixed(
+            AsyncScrollingMessage::generateMessages("   mixed", matrix, anim,
+              Font_5x7));
+          mixed.getLast()->setNext(playlist.getFirst());
+          player.show(mixed.getFirst());
+          HostEmulator::advance(random() % 200);
+        }
+        break;
+      case 7:
+        // loop back to any message, then let the chain go
+        if (!chain.isEmpty()) {
+          AsyncScrollingMessage* target = chain.getFirst();
+          for (unsigned long skip = random() % 4; skip > 0
+            && target->getNext() != nullptr; skip--) {
+            target = target->getNext();
+          }
+          chain.getLast()->setNext(target);
+          chain.clear();
+        }
+        break;
+      }
+    }
+    CHECK(played > 0);
+    CHECK_EQUAL(playlist.getMessageCount(), countLinks(playlist.getFirst()));
+
+    for (size_t i = 0; i < CHAINS; i++) {
+      chains[i].clear();
+      CHECK(chains[i].isEmpty());
+    }
+    CHECK_EQUAL(liveBefore + playlist.getMessageCount(),
+      AsyncScrollingStats::getLiveMessages());
+
+    // the matrix may still be playing frames from anim, which belongs to
+    // none of the chains, so this is safe
+    HostEmulator::advance(60000);
+  }
+
+  CHECK_EQUAL(liveBefore, AsyncScrollingStats::getLiveMessages());
+  CHECK_EQUAL(heapBefore, HostHeap::getLiveBytes());
+  return checkResult("test_chain");
+}
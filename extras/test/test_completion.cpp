@@ -0,0 +1,110 @@
+/**
+ * Completion test
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Runs the loop of the examples against the emulated matrix: setup kicks
+ * the completion so loop shows the first message, the matrix callback
+ * signals it, and a ticket is taken for every message shown. Each ticket
+ * has to stay not done for as long as its message is on the screen, and
+ * become done right when the message ends. Then the callback is signaled
+ * from another thread, like an interrupt, while loop polls. Every signal
+ * hands over a value the thread wrote before it, which loop reads after
+ * poll returns true. make check also builds this test with
+ * ThreadSanitizer, which reports a data race if poll does not see what was
+ * written before signal.
+ */
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include <thread>
+#include <vector>
+
+#include "AsyncScrollingCompletion.hpp"
+#include "AsyncScrollingMessage.hpp"
+#include "check.h"
+
+TEXT_ANIMATION_DEFINE(anim, 100)
+
+static AsyncScrollingCompletion done;
+
+static void matrixCallback() {
+  done.signal();
+}
+
+// tickets taken in loop follow the messages they were taken for
+static void testTickets() {
+  ArduinoLEDMatrix matrix;
+  matrix.textScrollSpeed(60);
+  matrix.setCallback(matrixCallback);
+  AsyncScrollingMessage message("   Hello", matrix, Font_5x7);
+
+  // kick starts loop without counting a message as done
+  CHECK(done.isIdle());
+  done.kick();
+  CHECK_EQUAL(1, done.getPending());
+  CHECK_EQUAL(0, done.getCount());
+
+  for (int shown = 0; shown < 3; shown++) {
+    CHECK(done.poll());
+    CHECK(!done.poll());
+    AsyncScrollingCompletion::Ticket ticket = done.start();
+    message.showMessage();
+    CHECK(!done.isDone(ticket));
+    CHECK(!done.isIdle());
+
+    // the callback comes when the last frame appears
+    unsigned long duration = matrix.getSequenceDuration();
+    HostEmulator::advance(duration - 1);
+    CHECK(!done.isDone(ticket));
+    CHECK_EQUAL(0, done.getPending());
+    HostEmulator::advance(1);
+    CHECK(done.isDone(ticket));
+    CHECK(done.isIdle());
+    CHECK_EQUAL(1, done.getPending());
+  }
+  CHECK(done.poll());
+  CHECK_EQUAL(3, done.getCount());
+}
+
+// a signal from an interrupt is never lost, however it falls between polls,
+// and what the interrupt wrote before it can be read after poll
+static void testInterrupt() {
+  AsyncScrollingCompletion completion;
+  const uint32_t signals = 200000;
+  AsyncScrollingCompletion::Ticket ticket = 0;
+  for (uint32_t i = 0; i < signals; i++) {
+    ticket = completion.start();
+  }
+  std::vector<uint32_t> values(signals);
+  std::thread interrupt([&completion, &values, signals]() {
+    for (uint32_t i = 0; i < signals; i++) {
+      values[i] = i + 1;
+      completion.signal();
+    }
+  });
+  completion.kick();
+  uint32_t polled = 0;
+  uint32_t wrong = 0;
+  while (polled < signals + 1) {
+    if (completion.poll()) {
+      // the first poll is the kick
+      polled++;
+      if (polled > 1 && values[polled - 2] != polled - 1) {
+        wrong++;
+      }
+    }
+  }
+  interrupt.join();
+  CHECK_EQUAL(0, wrong);
+  CHECK(!completion.poll());
+  CHECK_EQUAL(signals, completion.getCount());
+  CHECK(completion.isDone(ticket));
+  CHECK(!completion.isDone(ticket + 1));
+}
+
+int main() {
+  testTickets();
+  testInterrupt();
+  return checkResult("test_completion");
+}
@@ -0,0 +1,132 @@
+/**
+ * Compositor test
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Scrolls messages in regions of AsyncScrollingCompositor that start on
+ * different rows and are different heights, next to a still icon, and
+ * checks every frame against the text drawn on its own and moved to the
+ * region: the top of the text on the top row of the region, the rows below
+ * it cut off, and nothing drawn outside the region.
+ */
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include <string.h>
+
+#include "AsyncScrollingCompositor.hpp"
+#include "check.h"
+
+static const unsigned long SCROLL_SPEED = 50;
+
+static const uint32_t full[3] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF };
+
+static unsigned long called = 0;
+
+static void callback() {
+  called++;
+}
+
+// the frame the compositor should show: the icon region lit, and the text
+// drawn first columns to the left of the text region, then moved down so
+// its top is on row y and cut off below height rows
+static void expectedFrame(uint32_t frame[3], uint8_t iconWidth, uint8_t x,
+  uint8_t y, uint8_t width, uint8_t height, const char* text,
+  const Font& font, size_t columns) {
+  uint32_t drawn[3];
+  AsyncScrollingRender::clear(drawn);
+  AsyncScrollingRender::drawText(drawn, x - (int)columns, font, strlen(text),
+    [text](size_t i) { return text[i]; });
+
+  AsyncScrollingRender::clear(frame);
+  uint8_t rows = ((1 << height) - 1) << y;
+  for (uint8_t i = 0; i < iconWidth; i++) {
+    AsyncScrollingRender::setColumn(frame, i, 0xFF);
+  }
+  for (uint8_t i = x; i < x + width; i++) {
+    uint8_t pixels = AsyncScrollingRender::getColumn(drawn, i);
+    int shift = (int)y - (int)AsyncScrollingRender::TEXT_TOP;
+    pixels = shift >= 0 ? pixels << shift : pixels >> -shift;
+    AsyncScrollingRender::setColumn(frame, i, pixels & rows);
+  }
+}
+
+// scroll text in a region at x, y that is width by height, and count the
+// frames that are not as expected
+static void checkRegion(uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+  const Font& font) {
+  const char* text = "   Hello, regions 0123456789";
+  ArduinoLEDMatrix matrix;
+  AsyncScrollingClock::startVirtual(1000);
+  AsyncScrollingCompositor screen(matrix, SCROLL_SPEED);
+  uint8_t icon = screen.addRegion(0, 0, x, 8);
+  uint8_t region = screen.addRegion(x, y, width, height);
+  CHECK(icon != AsyncScrollingCompositor::NO_REGION);
+  CHECK(region != AsyncScrollingCompositor::NO_REGION);
+  screen.setFrame(icon, full);
+  screen.setCallback(region, callback);
+
+  AsyncScrollingMessage message(text, matrix, font);
+  called = 0;
+  screen.show(region, &message);
+  screen.update();
+  size_t frames = 0;
+  size_t wrong = 0;
+  while (called == 0 && frames < 1000) {
+    uint32_t expected[3];
+    expectedFrame(expected, x, x, y, width, height, text, font, frames);
+    if (memcmp(expected, screen.getFrame(), sizeof(expected)) != 0) {
+      wrong++;
+    }
+    AsyncScrollingClock::advance(SCROLL_SPEED);
+    screen.update();
+    frames++;
+  }
+  CHECK_EQUAL(message.getWidth(), frames);
+  CHECK_EQUAL(0, wrong);
+  AsyncScrollingClock::stopVirtual();
+}
+
+// still text is placed the same way as scrolling text
+static void checkText() {
+  ArduinoLEDMatrix matrix;
+  AsyncScrollingCompositor screen(matrix, SCROLL_SPEED);
+  uint8_t top = screen.addRegion(0, 0, 12, 3);
+  uint8_t bottom = screen.addRegion(0, 3, 12, 5);
+  screen.setText(top, "ab", Font_4x6);
+  screen.setText(bottom, "cd", Font_4x6);
+  screen.update();
+
+  uint32_t expected[3];
+  uint32_t drawn[3];
+  AsyncScrollingRender::clear(expected);
+  AsyncScrollingRender::clear(drawn);
+  AsyncScrollingRender::drawText(drawn, 0, Font_4x6, 2,
+    [](size_t i) { return "ab"[i]; });
+  for (size_t i = 0; i < 12; i++) {
+    AsyncScrollingRender::setColumn(expected, i,
+      (AsyncScrollingRender::getColumn(drawn, i) >> 1) & 0x07);
+  }
+  AsyncScrollingRender::clear(drawn);
+  AsyncScrollingRender::drawText(drawn, 0, Font_4x6, 2,
+    [](size_t i) { return "cd"[i]; });
+  for (size_t i = 0; i < 12; i++) {
+    AsyncScrollingRender::setColumn(expected, i,
+      AsyncScrollingRender::getColumn(expected, i)
+      | ((AsyncScrollingRender::getColumn(drawn, i) << 2) & 0xF8));
+  }
+  CHECK(memcmp(expected, screen.getFrame(), sizeof(expected)) == 0);
+  CHECK(AsyncScrollingRender::getColumn(screen.getFrame(), 0) != 0);
+}
+
+int main() {
+  // the whole height, the rows text uses on the whole screen, lower down
+  // and cut off at the bottom, and a short strip at the top
+  checkRegion(3, 0, 9, 8, Font_5x7);
+  checkRegion(3, 1, 9, 7, Font_5x7);
+  checkRegion(2, 2, 10, 6, Font_4x6);
+  checkRegion(2, 3, 8, 4, Font_5x7);
+  checkRegion(1, 0, 11, 3, Font_4x6);
+  checkText();
+  return checkResult("test_compositor");
+}
@@ -0,0 +1,143 @@
+/**
+ * CPU budget test
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Plays a 100 character message at 60 milliseconds per column, first drawn
+ * into an animation buffer by AsyncScrollingPlayer, then moved by
+ * AsyncScrollingScroller, and checks that AsyncScrollingCpu measures the
+ * library staying within its budget. The clock the library reads is the
+ * emulator's virtual clock plus a model of the board, which charges a fixed
+ * time for every frame drawn and every frame loaded, so the numbers do not
+ * depend on how fast the computer is. Drawing a frame more often than
+ * needed, or moving the scroll more often, makes the test fail.
+ *
+ *   make build/test_cpu && ./build/test_cpu
+ */
+
+#define ASYNC_SCROLLING_MESSAGE_CPU 1000
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include <string>
+
+#include "AsyncScrollingPlayer.hpp"
+#include "AsyncScrollingScroller.hpp"
+#include "check.h"
+
+TEXT_ANIMATION_DEFINE(anim, 700)
+
+static const unsigned long SCROLL_SPEED = 60;
+
+// the modeled time, in microseconds, to draw a frame of text with
+// ArduinoGraphics and to load a frame into the matrix
+static const unsigned long DRAW_MICROS = 200;
+static const unsigned long LOAD_MICROS = 20;
+
+// counts the frames drawn, which the emulated matrix does not
+class BoardMatrix : public ArduinoLEDMatrix {
+public:
+
+  void endDraw() override {
+    draws++;
+    ArduinoLEDMatrix::endDraw();
+  }
+
+  unsigned long draws = 0;
+};
+
+static BoardMatrix matrix;
+
+static unsigned long boardMicros() {
+  return (unsigned long)HostEmulator::getMicros() + matrix.draws * DRAW_MICROS
+    + matrix.getFrameLoads() * LOAD_MICROS;
+}
+
+static unsigned long boardMillis() {
+  return boardMicros() / 1000;
+}
+
+static bool done = false;
+
+static void callback() {
+  ASYNC_SCROLLING_CPU(CALLBACK);
+  done = true;
+}
+
+// start measuring over, and let a whole window go by, so the first
+// measurements are not of a window that has only just started
+static void startWindow() {
+  AsyncScrollingCpu::reset();
+  HostEmulator::advance(ASYNC_SCROLLING_MESSAGE_CPU);
+}
+
+struct Peaks {
+  float render;
+  float frame;
+  float total;
+};
+
+// run until the callback, and return the highest percentages measured
+static Peaks runUntilDone(AsyncScrollingScroller* scroller) {
+  Peaks peaks = { 0, 0, 0 };
+  done = false;
+  for (unsigned long ms = 0; !done && ms < 100000; ms++) {
+    HostEmulator::advance(1);
+    if (scroller != nullptr) {
+      scroller->update();
+    }
+    float render = AsyncScrollingCpu::getPercent(AsyncScrollingCpu::RENDER);
+    float frame = AsyncScrollingCpu::getPercent(AsyncScrollingCpu::FRAME);
+    float total = AsyncScrollingCpu::getPercent();
+    peaks.render = render > peaks.render ? render : peaks.render;
+    peaks.frame = frame > peaks.frame ? frame : peaks.frame;
+    peaks.total = total > peaks.total ? total : peaks.total;
+  }
+  CHECK(done);
+  return peaks;
+}
+
+int main() {
+  AsyncScrollingClock::setSource(boardMillis, boardMicros);
+  matrix.textScrollSpeed(SCROLL_SPEED);
+  matrix.setCallback(callback);
+
+  std::string text(100, 'x');
+  AsyncScrollingMessage message(text.c_str(), matrix, Font_5x7);
+  size_t frames = message.getFrameCount();
+  CHECK(frames <= AsyncScrollingMessage::getFrameCapacity(anim));
+
+  // the player draws every frame once, before the message plays
+  startWindow();
+  AsyncScrollingPlayer player(matrix, anim);
+  unsigned long draws = matrix.draws;
+  player.show(&message);
+  CHECK(matrix.draws - draws <= frames + 1);
+  Peaks played = runUntilDone(nullptr);
+  printf("player:   %zu frames, peak %.2f%% drawing, %.2f%% in all\n", frames,
+    played.render, played.total);
+  CHECK(played.render > 0);
+  CHECK(played.render < 15);
+  CHECK(played.total < 15);
+
+  // the scroller draws nothing ahead, and moves one column per frame
+  startWindow();
+  AsyncScrollingScroller scroller(matrix, SCROLL_SPEED);
+  scroller.setCallback(callback);
+  draws = matrix.draws;
+  unsigned long loads = matrix.getFrameLoads();
+  scroller.show(&message);
+  Peaks scrolled = runUntilDone(&scroller);
+  printf("scroller: %zu frames, peak %.2f%% moving, %.2f%% in all\n", frames,
+    scrolled.frame, scrolled.total);
+  CHECK_EQUAL(0, matrix.draws - draws);
+  CHECK_EQUAL(frames, matrix.getFrameLoads() - loads);
+  CHECK(scrolled.frame > 0);
+  CHECK(scrolled.frame < 0.1f);
+  CHECK(scrolled.total < 0.1f);
+  // every measurement turned interrupts back on
+  CHECK(!HostEmulator::areInterruptsOff());
+
+  AsyncScrollingClock::setSource(nullptr, nullptr);
+  return checkResult("test_cpu");
+}
@@ -0,0 +1,190 @@
+/**
+ * Duration test
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Plays random messages and chains, of random lengths, fonts and scroll
+ * speeds, as sequences on the emulated matrix, with showMessage and with
+ * AsyncScrollingPlayer, with and without batching, and checks that
+ * getSequenceDuration predicts exactly when the matrix calls its callback
+ * and that the player's getProgress goes from 0 to 1 over that time. The
+ * same chains are scrolled by AsyncScrollingScroller, which getDuration has
+ * to predict. Looping a chain back into any of its messages must not change
+ * what it predicts.
+ *
+ *   make build/test_duration && ./build/test_duration [cases] [seed]
+ */
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include <math.h>
+#include <random>
+
+#include "AsyncScrollingChain.hpp"
+#include "AsyncScrollingPlayer.hpp"
+#include "AsyncScrollingScroller.hpp"
+#include "check.h"
+
+TEXT_ANIMATION_DEFINE(anim, 200)
+TEXT_ANIMATION_DEFINE(spare, 200)
+
+static unsigned long called = 0;
+
+static void callback() {
+  called++;
+}
+
+static String randomText(std::mt19937& random, size_t length) {
+  String text;
+  for (size_t i = 0; i < length; i++) {
+    text += (char)('A' + random() % 26);
+  }
+  return text;
+}
+
+// the milliseconds from now until the callback is called
+static unsigned long untilCallback() {
+  unsigned long start = millis();
+  called = 0;
+  for (unsigned long ms = 0; called == 0 && ms < 1000000; ms++) {
+    HostEmulator::advance(1);
+  }
+  return millis() - start;
+}
+
+// play every message of the chain with showMessage, from the callback of
+// the one before it, and return how many took a different time than
+// predicted
+static unsigned long checkShowMessage(AsyncScrollingChain& chain,
+  unsigned long speed) {
+  unsigned long wrong = 0;
+  unsigned long start = millis();
+  for (AsyncScrollingMessage* m = chain.getFirst(); m != nullptr;
+    m = m->getNext()) {
+    m->showMessage(anim);
+    if (untilCallback() != m->getSequenceDuration(speed)) {
+      wrong++;
+    }
+  }
+  if (millis() - start != chain.getSequenceDuration(speed)) {
+    wrong++;
+  }
+  return wrong;
+}
+
+// play the chain with a player, checking the progress of every sequence
+// halfway through and at the callback
+static unsigned long checkPlayer(ArduinoLEDMatrix& matrix,
+  AsyncScrollingChain& chain, unsigned long speed, bool batching) {
+  AsyncScrollingPlayer player(matrix, anim, spare);
+  if (batching) {
+    player.enableBatching(speed);
+  }
+  unsigned long wrong = 0;
+  AsyncScrollingMessage* next = chain.getFirst();
+  while (next != nullptr) {
+    AsyncScrollingMessage* shown = next;
+    next = player.show(next);
+    unsigned long duration = matrix.getSequenceDuration();
+    if (player.getBatchCount() == 1
+      && duration != shown->getSequenceDuration(speed)) {
+      wrong++;
+    }
+    if (player.getProgress() != 0) {
+      wrong++;
+    }
+
+    HostEmulator::advance(duration / 2);
+    float expected = (float)(duration / 2) / duration;
+    if (duration > 0 && fabsf(player.getProgress() - expected) > 0.001f) {
+      wrong++;
+    }
+    unsigned long rest = untilCallback();
+    if (duration / 2 + rest != duration || player.getProgress() != 1) {
+      wrong++;
+    }
+  }
+  return wrong;
+}
+
+// scroll the chain and return how many messages took a different time than
+// predicted
+static unsigned long checkScroller(ArduinoLEDMatrix& matrix,
+  AsyncScrollingChain& chain, unsigned long speed) {
+  AsyncScrollingClock::startVirtual(millis());
+  AsyncScrollingScroller scroller(matrix, speed);
+  scroller.setCallback(callback);
+  unsigned long wrong = 0;
+  unsigned long start = AsyncScrollingClock::millis();
+  for (AsyncScrollingMessage* m = chain.getFirst(); m != nullptr;
+    m = m->getNext()) {
+    unsigned long shown = AsyncScrollingClock::millis();
+    called = 0;
+    scroller.show(m);
+    while (called == 0) {
+      AsyncScrollingClock::advance(1);
+      scroller.update();
+    }
+    if (AsyncScrollingClock::millis() - shown != m->getDuration(speed)) {
+      wrong++;
+    }
+  }
+  if (AsyncScrollingClock::millis() - start != chain.getDuration(speed)) {
+    wrong++;
+  }
+  AsyncScrollingClock::stopVirtual();
+  return wrong;
+}
+
+int main(int argc, char** argv) {
+  int cases = argc > 1 ? atoi(argv[1]) : 100;
+  std::mt19937 random(argc > 2 ? strtoul(argv[2], nullptr, 10) : 5);
+  ArduinoLEDMatrix matrix;
+  matrix.setCallback(callback);
+
+  unsigned long wrongShow = 0;
+  unsigned long wrongPlayer = 0;
+  unsigned long wrongBatch = 0;
+  unsigned long wrongScroller = 0;
+  unsigned long wrongLoop = 0;
+  for (int i = 0; i < cases; i++) {
+    unsigned long speed = 20 + random() % 80;
+    matrix.textScrollSpeed(speed);
+    const Font& font = random() % 2 == 0 ? Font_5x7 : Font_4x6;
+
+    // a long text in parts, then short words that can be batched, some of
+    // them still
+    AsyncScrollingChain chain(AsyncScrollingMessage::generateMessages(
+      randomText(random, 1 + random() % 120), matrix, anim, font));
+    for (int word = 0; word < 4; word++) {
+      chain.append(AsyncScrollingChain(AsyncScrollingMessage::generateMessages(
+        randomText(random, 1 + random() % 6), matrix, anim, font)));
+    }
+
+    wrongShow += checkShowMessage(chain, speed);
+    wrongPlayer += checkPlayer(matrix, chain, speed, false);
+    wrongBatch += checkPlayer(matrix, chain, speed, true);
+    wrongScroller += checkScroller(matrix, chain, speed);
+
+    size_t frames = chain.getFrameCount();
+    unsigned long duration = chain.getDuration(speed);
+    unsigned long sequence = chain.getSequenceDuration(speed);
+    AsyncScrollingMessage* target = chain.getFirst();
+    for (unsigned long skip = random() % 8; skip > 0
+      && target->getNext() != nullptr; skip--) {
+      target = target->getNext();
+    }
+    chain.getLast()->setNext(target);
+    if (chain.getFrameCount() != frames
+      || chain.getDuration(speed) != duration
+      || chain.getSequenceDuration(speed) != sequence) {
+      wrongLoop++;
+    }
+  }
+  CHECK_EQUAL(0, wrongShow);
+  CHECK_EQUAL(0, wrongPlayer);
+  CHECK_EQUAL(0, wrongBatch);
+  CHECK_EQUAL(0, wrongScroller);
+  CHECK_EQUAL(0, wrongLoop);
+  return checkResult("test_duration");
+}
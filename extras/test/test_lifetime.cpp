@@ -0,0 +1,117 @@
+/**
+ * Chain lifetime test
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Destroys a chain from generateMessages half way through scrolling it,
+ * with the matrix playing it as a sequence, with AsyncScrollingScroller and
+ * with AsyncScrollingCompositor, and keeps the display running afterwards.
+ * The matrix only reads the animation buffer, the scroller and compositor
+ * are stopped first, as the chain's documentation asks. Built with
+ * AddressSanitizer, reading a deleted message fails the test.
+ */
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include "AsyncScrollingChain.hpp"
+#include "AsyncScrollingCompositor.hpp"
+#include "AsyncScrollingScroller.hpp"
+#include "check.h"
+
+TEXT_ANIMATION_DEFINE(anim, 40)
+
+static const unsigned long SCROLL_SPEED = 60;
+
+static const char text[] =
+  "   a long text that is split into several parts for the buffer";
+
+static unsigned long called = 0;
+
+static void callback() {
+  called++;
+}
+
+static AsyncScrollingChain* makeChain(ArduinoLEDMatrix& matrix) {
+  AsyncScrollingChain* chain = new AsyncScrollingChain(
+    AsyncScrollingMessage::generateMessages(text, matrix, anim, Font_5x7));
+  CHECK(chain->getFirst()->hasContinuation());
+  return chain;
+}
+
+// the sequence keeps playing from the buffer after the chain is gone
+static void testSequence(ArduinoLEDMatrix& matrix) {
+  AsyncScrollingChain* chain = makeChain(matrix);
+  called = 0;
+  chain->getFirst()->showMessage(anim);
+  HostEmulator::advance(5 * SCROLL_SPEED);
+  delete chain;
+  HostEmulator::advance(100 * SCROLL_SPEED);
+  CHECK_EQUAL(1, called);
+}
+
+static void testScroller(ArduinoLEDMatrix& matrix) {
+  AsyncScrollingChain* chain = makeChain(matrix);
+  AsyncScrollingScroller scroller(matrix, SCROLL_SPEED);
+  scroller.setCallback(callback);
+  called = 0;
+  scroller.show(chain->getFirst());
+  for (int i = 0; i < 5; i++) {
+    AsyncScrollingClock::advance(SCROLL_SPEED);
+    scroller.update();
+  }
+  CHECK(scroller.isScrolling());
+  uint32_t frame[3];
+  memcpy(frame, matrix.getFrame(), sizeof(frame));
+
+  scroller.stop();
+  CHECK(!scroller.isScrolling());
+  delete chain;
+  for (int i = 0; i < 100; i++) {
+    AsyncScrollingClock::advance(SCROLL_SPEED);
+    scroller.update();
+    scroller.tick();
+  }
+  CHECK_EQUAL(0, called);
+  CHECK(memcmp(frame, matrix.getFrame(), sizeof(frame)) == 0);
+  CHECK_EQUAL(0, scroller.getRemaining());
+}
+
+static void testCompositor(ArduinoLEDMatrix& matrix) {
+  AsyncScrollingChain* chain = makeChain(matrix);
+  AsyncScrollingCompositor screen(matrix, SCROLL_SPEED);
+  uint8_t left = screen.addRegion(0, 1, 6, 7);
+  uint8_t right = screen.addRegion(6, 1, 6, 7);
+  screen.setCallback(left, callback);
+  screen.setCallback(right, callback);
+  called = 0;
+  screen.show(left, chain->getFirst());
+  screen.show(right, chain->getFirst()->getNext());
+  for (int i = 0; i < 5; i++) {
+    AsyncScrollingClock::advance(SCROLL_SPEED);
+    screen.update();
+  }
+
+  screen.stop(left);
+  screen.stop(right);
+  CHECK(!screen.isScrolling(left));
+  CHECK(!screen.isScrolling(right));
+  delete chain;
+  for (int i = 0; i < 100; i++) {
+    AsyncScrollingClock::advance(SCROLL_SPEED);
+    screen.update();
+  }
+  CHECK_EQUAL(0, called);
+}
+
+int main() {
+  ArduinoLEDMatrix matrix;
+  matrix.textScrollSpeed(SCROLL_SPEED);
+  matrix.setCallback(callback);
+  testSequence(matrix);
+
+  AsyncScrollingClock::startVirtual(1000);
+  testScroller(matrix);
+  testCompositor(matrix);
+  AsyncScrollingClock::stopVirtual();
+  return checkResult("test_lifetime");
+}
@@ -0,0 +1,125 @@
+/**
+ * Message move test
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Counts the heap allocations of creating messages from temporary Strings
+ * and of storing them by value in a std::vector. A temporary String is
+ * moved into the message, so the only allocation is the text the caller
+ * built, and moving messages around never copies their text.
+ */
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include <vector>
+
+#include "AsyncScrollingChain.hpp"
+#include "check.h"
+
+TEXT_ANIMATION_DEFINE(anim, 100)
+
+static const size_t MESSAGES = 100;
+
+static String build(size_t i) {
+  String text("   built text ");
+  text += (char)('a' + i % 26);
+  return text;
+}
+
+// a temporary String is moved in, a String that is kept is copied
+static void testFromTemporary(ArduinoLEDMatrix& matrix) {
+  unsigned long allocations = HostHeap::getAllocations();
+  AsyncScrollingMessage moved(build(0), matrix, Font_5x7);
+  unsigned long built = HostHeap::getAllocations() - allocations;
+
+  String kept = build(0);
+  allocations = HostHeap::getAllocations();
+  AsyncScrollingMessage copied(kept, matrix, Font_5x7);
+  CHECK_EQUAL(1, HostHeap::getAllocations() - allocations);
+
+  // building the text is all the moved message cost
+  allocations = HostHeap::getAllocations();
+  build(0);
+  CHECK_EQUAL(HostHeap::getAllocations() - allocations, built);
+  CHECK(moved.getMessage() == kept.c_str());
+
+  // a single part from generateMessages takes over the String too
+  CHECK_EQUAL(1, AsyncScrollingPlan(build(1).length(), Font_5x7.width,
+    matrix.width(), AsyncScrollingMessage::getFrameCapacity(anim))
+    .getChunkCount());
+  allocations = HostHeap::getAllocations();
+  AsyncScrollingChain chain(AsyncScrollingMessage::generateMessages(
+    build(1), matrix, anim, Font_5x7));
+  CHECK_EQUAL(built + 1, HostHeap::getAllocations() - allocations);
+}
+
+// moving a message takes its text and next message and leaves it empty
+static void testMove(ArduinoLEDMatrix& matrix) {
+  AsyncScrollingMessage second("   second", matrix, Font_5x7);
+  AsyncScrollingMessage first("   first", matrix, Font_5x7);
+  first.setNext(&second);
+
+  unsigned long allocations = HostHeap::getAllocations();
+  AsyncScrollingMessage moved(std::move(first));
+  CHECK_EQUAL(0, HostHeap::getAllocations() - allocations);
+  CHECK(moved.getMessage() == "   first");
+  CHECK(moved.getNext() == &second);
+  CHECK_EQUAL(0, first.getLength());
+  CHECK(!first.hasNext());
+
+  AsyncScrollingMessage assigned("   replaced", matrix, Font_4x6);
+  allocations = HostHeap::getAllocations();
+  assigned = std::move(moved);
+  CHECK_EQUAL(0, HostHeap::getAllocations() - allocations);
+  CHECK(assigned.getMessage() == "   first");
+  CHECK(assigned.getNext() == &second);
+  CHECK_EQUAL(0, moved.getLength());
+  CHECK(!moved.hasNext());
+}
+
+// messages stored by value cost the text and the vector, and growing the
+// vector moves them without copying any text
+static void testVector(ArduinoLEDMatrix& matrix) {
+  unsigned long allocations = HostHeap::getAllocations();
+  for (size_t i = 0; i < MESSAGES; i++) {
+    build(i);
+  }
+  unsigned long texts = HostHeap::getAllocations() - allocations;
+
+  std::vector<AsyncScrollingMessage> messages;
+  messages.reserve(MESSAGES);
+  allocations = HostHeap::getAllocations();
+  for (size_t i = 0; i < MESSAGES; i++) {
+    messages.emplace_back(build(i), matrix, Font_5x7);
+  }
+  CHECK_EQUAL(texts, HostHeap::getAllocations() - allocations);
+
+  // without reserve the vector reallocates and moves every message
+  std::vector<AsyncScrollingMessage> grown;
+  allocations = HostHeap::getAllocations();
+  for (size_t i = 0; i < MESSAGES; i++) {
+    grown.push_back(AsyncScrollingMessage(build(i), matrix, Font_5x7));
+  }
+  unsigned long growth = 0;
+  for (size_t capacity = 1; capacity <= grown.capacity(); capacity *= 2) {
+    growth++;
+  }
+  CHECK_EQUAL(texts + growth, HostHeap::getAllocations() - allocations);
+
+  for (size_t i = 0; i < MESSAGES; i++) {
+    CHECK(messages[i].getMessage() == build(i).c_str());
+    CHECK(grown[i].getMessage() == build(i).c_str());
+  }
+}
+
+int main() {
+  ArduinoLEDMatrix matrix;
+  matrix.textScrollSpeed(60);
+
+  size_t heap = HostHeap::getLiveBytes();
+  testFromTemporary(matrix);
+  testMove(matrix);
+  testVector(matrix);
+  CHECK_EQUAL(heap, HostHeap::getLiveBytes());
+  return checkResult("test_move");
+}
@@ -0,0 +1,129 @@
+/**
+ * Pacer jitter test
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Scrolls a long text in parts with AsyncScrollingScroller::update, from a
+ * loop that takes a random time to come around, from 1 millisecond to
+ * almost a whole frame, on a virtual clock. Every frame has to be shown
+ * within one frame period of its ideal time, counting from the first frame
+ * of the first part, and the last part has to end when the frames of every
+ * part add up to, so late frames never add up to drift.
+ *
+ *   make build/test_pacer && ./build/test_pacer [seed]
+ */
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include <random>
+#include <string>
+
+#include "AsyncScrollingChain.hpp"
+#include "AsyncScrollingScroller.hpp"
+#include "check.h"
+
+static const unsigned long SCROLL_SPEED = 60;
+
+static bool done = false;
+
+static void callback() {
+  done = true;
+}
+
+// a late frame makes the next one due sooner, not later
+static void testCatchUp() {
+  AsyncScrollingClock::startVirtual(1000);
+  AsyncScrollingPacer pacer;
+  pacer.start(SCROLL_SPEED);
+  CHECK(!pacer.isDue());
+  CHECK_EQUAL(SCROLL_SPEED, pacer.getTimeUntilDue());
+
+  AsyncScrollingClock::advance(SCROLL_SPEED + 40);
+  CHECK(pacer.isDue());
+  pacer.next(SCROLL_SPEED);
+  CHECK_EQUAL(40, pacer.getDrift());
+  CHECK_EQUAL(SCROLL_SPEED - 40, pacer.getTimeUntilDue());
+
+  // two frames were missed, so they are due right away after this one
+  AsyncScrollingClock::advance(3 * SCROLL_SPEED);
+  unsigned long caughtUp = 0;
+  while (pacer.isDue()) {
+    pacer.next(SCROLL_SPEED);
+    caughtUp++;
+  }
+  CHECK_EQUAL(3, caughtUp);
+  CHECK_EQUAL(40, pacer.getDrift());
+  CHECK_EQUAL(2 * SCROLL_SPEED + 40, pacer.getMaxLateness());
+}
+
+int main(int argc, char** argv) {
+  std::mt19937 random(argc > 1 ? strtoul(argv[1], nullptr, 10) : 7);
+  testCatchUp();
+
+  ArduinoLEDMatrix matrix;
+  std::string text(3000, 'x');
+  for (size_t i = 0; i < text.size(); i += 7) {
+    text[i] = ' ';
+  }
+  AsyncScrollingChain parts(AsyncScrollingMessage::generateMessages(
+    text.c_str(), matrix, 100, Font_5x7));
+  size_t frames = 0;
+  size_t count = 0;
+  for (AsyncScrollingMessage* m = parts.getFirst(); m != nullptr;
+    m = m->getNext()) {
+    frames += m->getFrameCount();
+    count++;
+  }
+  CHECK(count > 10);
+
+  AsyncScrollingScroller scroller(matrix, SCROLL_SPEED);
+  scroller.setCallback(callback);
+  AsyncScrollingClock::startVirtual(5000);
+  unsigned long start = AsyncScrollingClock::millis();
+  AsyncScrollingMessage* next = parts.getFirst();
+  scroller.show(next);
+  next = next->getNext();
+
+  unsigned long loads = matrix.getFrameLoads();
+  unsigned long shown = 1;
+  long earliest = 0;
+  long latest = 0;
+  unsigned long end = 0;
+  while (end == 0) {
+    // most loops are quick, some take almost a whole frame
+    unsigned long loop = random() % 10 == 0 ? 1 + random() % (SCROLL_SPEED - 1)
+      : 1 + random() % 25;
+    AsyncScrollingClock::advance(loop);
+    scroller.update();
+    if (done) {
+      done = false;
+      if (next != nullptr) {
+        scroller.show(next);
+        next = next->getNext();
+      } else {
+        end = AsyncScrollingClock::millis();
+      }
+    }
+
+    if (matrix.getFrameLoads() != loads) {
+      loads = matrix.getFrameLoads();
+      long late = (long)(AsyncScrollingClock::millis() - start)
+        - (long)(shown * SCROLL_SPEED);
+      earliest = late < earliest ? late : earliest;
+      latest = late > latest ? late : latest;
+      shown++;
+    }
+  }
+
+  long drift = (long)(end - start) - (long)(frames * SCROLL_SPEED);
+  printf("%zu parts, %zu frames, frames shown %ld to %ld ms after their "
+    "ideal time, %ld ms drift at the end\n", count, frames, earliest, latest,
+    drift);
+  CHECK_EQUAL(frames, shown);
+  CHECK(earliest >= 0);
+  CHECK(latest < (long)SCROLL_SPEED);
+  CHECK(drift >= 0);
+  CHECK(drift < (long)SCROLL_SPEED);
+  CHECK(scroller.getPacer().getMaxLateness() < (long)SCROLL_SPEED);
+  return checkResult("test_pacer");
+}
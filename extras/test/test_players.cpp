@@ -0,0 +1,180 @@
+/**
+ * Two player test
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Runs two players at the same time on two emulated matrices, one with two
+ * animation buffers and one with a single buffer of its own, the way a
+ * sketch would from loop(). Each matrix has to show exactly the frames it
+ * shows when a player with a single buffer runs alone, so neither player
+ * draws into a buffer that is playing, its own or the other one's.
+ *
+ * A player whose spare buffer is smaller than its first one has to batch
+ * and draw for the smaller buffer, and show the same frames as a player
+ * with only that buffer.
+ */
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include <vector>
+
+#include "AsyncScrollingChain.hpp"
+#include "AsyncScrollingPlayer.hpp"
+#include "check.h"
+
+TEXT_ANIMATION_DEFINE(animA, 40)
+TEXT_ANIMATION_DEFINE(animB, 40)
+TEXT_ANIMATION_DEFINE(animC, 25)
+
+typedef std::vector<std::vector<uint32_t>> Frames;
+
+struct Screen {
+  ArduinoLEDMatrix* matrix;
+  AsyncScrollingPlayer* player;
+  AsyncScrollingChain chain;
+  AsyncScrollingMessage* next;
+  unsigned long shown;
+  Frames frames;
+};
+
+static volatile bool doneA = false;
+static volatile bool doneB = false;
+
+static void callbackA() {
+  doneA = true;
+}
+
+static void callbackB() {
+  doneB = true;
+}
+
+static void start(Screen& screen, ArduinoLEDMatrix& matrix,
+  AsyncScrollingPlayer& player, const char* text, const Font& font) {
+  screen.matrix = &matrix;
+  screen.player = &player;
+  screen.chain = AsyncScrollingChain(AsyncScrollingMessage::generateMessages(
+    text, matrix, player.getFrameCapacity(), font));
+  screen.next = player.show(screen.chain.getFirst());
+  screen.shown = matrix.getFramesShown() - 1;
+  screen.frames.clear();
+}
+
+// what loop() does: show the next message when the last one is done, and
+// note every frame that appears
+static bool update(Screen& screen, volatile bool& done) {
+  if (screen.matrix->getFramesShown() != screen.shown) {
+    const uint32_t* frame = screen.matrix->getFrame();
+    screen.frames.push_back(std::vector<uint32_t>(frame, frame + 3));
+    screen.shown = screen.matrix->getFramesShown();
+  }
+  if (!done) {
+    return true;
+  }
+  done = false;
+  if (screen.next == nullptr) {
+    return false;
+  }
+  screen.next = screen.player->show(screen.next);
+  screen.shown = screen.matrix->getFramesShown() - 1;
+  return true;
+}
+
+static const char textA[] =
+  "   the first matrix shows a message long enough for several parts";
+static const char textB[] =
+  "   and the second one shows another, in a different font";
+
+// runs the first matrix with a spare buffer if spare is true
+static void run(bool runA, bool runB, bool spare, Frames& framesA,
+  Frames& framesB) {
+  ArduinoLEDMatrix matrixA;
+  ArduinoLEDMatrix matrixB;
+  matrixA.textScrollSpeed(60);
+  matrixB.textScrollSpeed(45);
+  matrixA.setCallback(callbackA);
+  matrixB.setCallback(callbackB);
+  AsyncScrollingPlayer playerA = spare
+    ? AsyncScrollingPlayer(matrixA, animA, animB)
+    : AsyncScrollingPlayer(matrixA, animA);
+  AsyncScrollingPlayer playerB(matrixB, animC);
+
+  Screen a;
+  Screen b;
+  bool busyA = runA;
+  bool busyB = runB;
+  if (runA) {
+    start(a, matrixA, playerA, textA, Font_5x7);
+    CHECK(a.chain.getFirst()->hasContinuation());
+  }
+  if (runB) {
+    start(b, matrixB, playerB, textB, Font_4x6);
+    CHECK(b.chain.getFirst()->hasContinuation());
+  }
+  while (busyA || busyB) {
+    HostEmulator::advance(1);
+    if (busyA) {
+      busyA = update(a, doneA);
+    }
+    if (busyB) {
+      busyB = update(b, doneB);
+    }
+  }
+  framesA = a.frames;
+  framesB = b.frames;
+}
+
+// play short words with batching and return the frames the matrix showed
+static Frames runBatches(AsyncScrollingPlayer& player,
+  ArduinoLEDMatrix& matrix) {
+  Screen screen;
+  screen.matrix = &matrix;
+  screen.player = &player;
+  player.enableBatching(60);
+  for (int i = 0; i < 8; i++) {
+    screen.chain.append(AsyncScrollingChain(
+      AsyncScrollingMessage::generateMessages(
+        "abc", matrix, player.getFrameCapacity(), Font_5x7)));
+  }
+  screen.next = player.show(screen.chain.getFirst());
+  screen.shown = matrix.getFramesShown() - 1;
+  while (update(screen, doneA)) {
+    HostEmulator::advance(1);
+  }
+  return screen.frames;
+}
+
+// two words of 15 columns fit in animA together but not in animC
+static void testUnequalBuffers() {
+  ArduinoLEDMatrix matrix;
+  matrix.textScrollSpeed(60);
+  matrix.setCallback(callbackA);
+
+  AsyncScrollingPlayer alone(matrix, animC);
+  Frames expected = runBatches(alone, matrix);
+  AsyncScrollingPlayer player(matrix, animA, animC);
+  CHECK_EQUAL(alone.getFrameCapacity(), player.getFrameCapacity());
+  Frames frames = runBatches(player, matrix);
+  CHECK(!expected.empty());
+  CHECK(frames == expected);
+}
+
+int main() {
+  Frames aloneA;
+  Frames aloneB;
+  Frames unused;
+  run(true, false, false, aloneA, unused);
+  run(false, true, false, unused, aloneB);
+  CHECK(aloneA.size() > animA[0][0]);
+  CHECK(aloneB.size() > animC[0][0]);
+
+  Frames togetherA;
+  Frames togetherB;
+  run(true, true, true, togetherA, togetherB);
+  CHECK_EQUAL(aloneA.size(), togetherA.size());
+  CHECK_EQUAL(aloneB.size(), togetherB.size());
+  CHECK(aloneA == togetherA);
+  CHECK(aloneB == togetherB);
+
+  testUnequalBuffers();
+  return checkResult("test_players");
+}
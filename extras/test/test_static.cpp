@@ -0,0 +1,116 @@
+/**
+ * Still message test
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * A message that fits on the screen is shown as one still frame, without
+ * drawing a scroll, and the matrix calls the callback once it has been on
+ * the screen for the static duration, just like when a scrolling message
+ * is done. A buffer with room for only one frame shows it and ends right
+ * away, and one with no room shows nothing, without writing past either.
+ */
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include "AsyncScrollingPlayer.hpp"
+#include "check.h"
+
+TEXT_ANIMATION_DEFINE(anim, 60)
+TEXT_ANIMATION_DEFINE(other, 60)
+TEXT_ANIMATION_DEFINE(one, 1)
+TEXT_ANIMATION_DEFINE(none, 0)
+
+static unsigned long called = 0;
+static unsigned long calledAt = 0;
+
+static void callback() {
+  called++;
+  calledAt = millis();
+}
+
+static bool isBlank(const uint32_t* frame) {
+  return frame[0] == 0 && frame[1] == 0 && frame[2] == 0;
+}
+
+// shows message and checks it stays still for duration milliseconds
+static void checkStill(ArduinoLEDMatrix& matrix, unsigned long duration) {
+  unsigned long start = millis();
+  unsigned long shown = matrix.getFramesShown();
+  uint32_t frame[3];
+  memcpy(frame, matrix.getFrame(), sizeof(frame));
+  CHECK(!isBlank(frame));
+  CHECK_EQUAL(2, matrix.getSequenceLength());
+
+  called = 0;
+  HostEmulator::advance(duration - 1);
+  CHECK_EQUAL(0, called);
+  CHECK(memcmp(frame, matrix.getFrame(), sizeof(frame)) == 0);
+  HostEmulator::advance(1);
+  CHECK_EQUAL(1, called);
+  CHECK_EQUAL(start + duration, calledAt);
+
+  // the frame is loaded again at the end, unchanged, and stays
+  CHECK_EQUAL(shown + 1, matrix.getFramesShown());
+  CHECK(memcmp(frame, matrix.getFrame(), sizeof(frame)) == 0);
+  HostEmulator::advance(10000);
+  CHECK_EQUAL(1, called);
+  CHECK(memcmp(frame, matrix.getFrame(), sizeof(frame)) == 0);
+}
+
+// buffers too small to list the frame twice
+static void testSmallBuffers(ArduinoLEDMatrix& matrix,
+  AsyncScrollingMessage& still) {
+  still.showMessage();
+  HostEmulator::advance(still.getStaticDuration());
+  uint32_t frame[3];
+  memcpy(frame, matrix.getFrame(), sizeof(frame));
+
+  called = 0;
+  still.showMessage(one);
+  CHECK_EQUAL(1, matrix.getSequenceLength());
+  CHECK_EQUAL(1, called);
+  CHECK(memcmp(frame, matrix.getFrame(), sizeof(frame)) == 0);
+
+  AsyncScrollingPlayer player(matrix, one);
+  called = 0;
+  CHECK(player.show(&still) == nullptr);
+  CHECK_EQUAL(1, called);
+  CHECK(player.getProgress() == 1);
+
+  unsigned long shown = matrix.getFramesShown();
+  called = 0;
+  still.showMessage(none);
+  HostEmulator::advance(10000);
+  CHECK_EQUAL(0, called);
+  CHECK_EQUAL(shown, matrix.getFramesShown());
+}
+
+int main() {
+  ArduinoLEDMatrix matrix;
+  matrix.textScrollSpeed(60);
+  matrix.setCallback(callback);
+
+  AsyncScrollingMessage still(":)", matrix, Font_5x7);
+  CHECK(still.isStatic());
+  CHECK_EQUAL(1, still.getFrameCount());
+  CHECK_EQUAL(ASYNC_SCROLLING_MESSAGE_STATIC_DURATION, still.getDuration(60));
+  still.showMessage();
+  checkStill(matrix, ASYNC_SCROLLING_MESSAGE_STATIC_DURATION);
+
+  still.setStaticDuration(2000);
+  CHECK_EQUAL(2000, still.getDuration(60));
+  still.showMessage();
+  checkStill(matrix, 2000);
+
+  // the same through a player with its own buffer
+  AsyncScrollingPlayer player(matrix, other);
+  CHECK(player.show(&still) == nullptr);
+  checkStill(matrix, 2000);
+
+  testSmallBuffers(matrix, still);
+
+  // three characters of the 5 column font do not fit, so they scroll
+  AsyncScrollingMessage scrolling("abc", matrix, Font_5x7);
+  CHECK(!scrolling.isStatic());
+  return checkResult("test_static");
+}
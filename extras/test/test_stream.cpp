@@ -0,0 +1,196 @@
+/**
+ * Stream flow control test
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Sends 10 MB of text to an AsyncScrollingStream through an emulated serial
+ * port, at a rate that keeps changing between nothing, about the speed the
+ * text scrolls at, and far faster. The port has a 64 byte receive buffer
+ * that drops bytes when it is full, like a UART, and the sender keeps
+ * sending a few bytes after XOFF, like bytes already on the wire. Every
+ * column that reaches the screen is checked against the text, so a dropped,
+ * repeated or reordered byte is found, and every line has to be reported.
+ *
+ *   make build/test_stream && ./build/test_stream [bytes] [seed]
+ */
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include <deque>
+#include <random>
+
+#include "AsyncScrollingStream.hpp"
+#include "check.h"
+
+static const size_t RECEIVE_BUFFER = 64;
+static const size_t IN_FLIGHT = 4;
+
+class SerialPort : public Stream {
+public:
+
+  SerialPort()
+    : paused(false),
+      pausing(0),
+      dropped(0),
+      pauses(0) {
+  }
+
+  // a byte from the sender, dropped if the receive buffer is full
+  void deliver(uint8_t c) {
+    if (received.size() >= RECEIVE_BUFFER) {
+      dropped++;
+    } else {
+      received.push_back(c);
+    }
+    if (pausing > 0 && --pausing == 0) {
+      paused = true;
+    }
+  }
+
+  // true if the sender may send another byte
+  bool isClear() const {
+    return !paused;
+  }
+
+  size_t write(uint8_t c) override {
+    if (c == AsyncScrollingStream::XOFF && !paused && pausing == 0) {
+      pausing = IN_FLIGHT;
+      pauses++;
+    } else if (c == AsyncScrollingStream::XON) {
+      paused = false;
+      pausing = 0;
+    }
+    return 1;
+  }
+
+  int available() override {
+    return received.size();
+  }
+
+  int read() override {
+    if (received.empty()) {
+      return -1;
+    }
+    int c = received.front();
+    received.pop_front();
+    return c;
+  }
+
+  int peek() override {
+    return received.empty() ? -1 : received.front();
+  }
+
+  std::deque<uint8_t> received;
+  bool paused;
+  size_t pausing;
+  unsigned long dropped;
+  unsigned long pauses;
+};
+
+// the columns the text should scroll as, one character at a time
+class Expected {
+public:
+
+  explicit Expected(const Font& font)
+    : font(font),
+      column(0),
+      blank(0) {
+  }
+
+  void add(char c) {
+    text.push_back(c);
+  }
+
+  bool isEmpty() const {
+    return text.empty() && blank == 0;
+  }
+
+  uint8_t next() {
+    if (blank > 0) {
+      blank--;
+      return 0;
+    }
+    char c = text.front();
+    if (c == '\n') {
+      text.pop_front();
+      blank = AsyncScrollingRender::SCREEN_WIDTH - 1;
+      return 0;
+    }
+    uint8_t pixels = AsyncScrollingRender::glyphColumn(font, c, column);
+    if (++column == (size_t)font.width) {
+      column = 0;
+      text.pop_front();
+    }
+    return pixels;
+  }
+
+private:
+
+  const Font& font;
+  std::deque<char> text;
+  size_t column;
+  size_t blank;
+};
+
+int main(int argc, char** argv) {
+  size_t total = argc > 1 ? strtoul(argv[1], nullptr, 10) : 10000000;
+  std::mt19937 random(argc > 2 ? strtoul(argv[2], nullptr, 10) : 1);
+
+  ArduinoLEDMatrix matrix;
+  SerialPort port;
+  char buffer[64];
+  // one column a millisecond, so 10 MB scroll by in a few simulated days
+  AsyncScrollingStream stream(matrix, port, buffer, Font_4x6, 1);
+  Expected expected(Font_4x6);
+
+  size_t sent = 0;
+  unsigned long newlines = 0;
+  unsigned long columns = 0;
+  unsigned long wrong = 0;
+  unsigned long loads = matrix.getFrameLoads();
+  unsigned long step = 0;
+  // runs until everything was sent and the text has stopped moving
+  unsigned long still = 0;
+  while (sent < total || !port.received.empty() || still < 100) {
+    // the rate changes every second: nothing, a little slower than the text
+    // scrolls, or much faster
+    step++;
+    unsigned long phase = (step / 1000) % 4;
+    size_t rate = phase == 0 ? 0 : phase == 1 ? 1 : phase == 2 ? 8 : 40;
+    if (phase == 1 && random() % 5 != 0) {
+      rate = 0;
+    }
+    for (size_t i = 0; i < rate && sent < total && port.isClear(); i++) {
+      char c = random() % 30 == 0 ? '\n' : (char)('a' + random() % 26);
+      newlines += c == '\n';
+      expected.add(c);
+      port.deliver(c);
+      sent++;
+    }
+
+    HostEmulator::advance(1);
+    stream.update();
+
+    still++;
+    if (matrix.getFrameLoads() != loads) {
+      still = 0;
+      loads = matrix.getFrameLoads();
+      uint8_t shown = AsyncScrollingRender::getColumn(
+        matrix.getFrame(), AsyncScrollingRender::SCREEN_WIDTH - 1);
+      if (expected.isEmpty() || shown != expected.next()) {
+        wrong++;
+      }
+      columns++;
+    }
+  }
+
+  printf("%zu bytes, %lu columns, %lu pauses, %lu underruns\n", sent,
+    columns, port.pauses, stream.getUnderruns());
+  CHECK_EQUAL(0, port.dropped);
+  CHECK_EQUAL(0, wrong);
+  CHECK(expected.isEmpty());
+  CHECK_EQUAL(newlines, stream.getLines());
+  CHECK(port.pauses > 0);
+  CHECK(stream.getUnderruns() > 0);
+  return checkResult("test_stream");
+}
@@ -0,0 +1,170 @@
+/**
+ * Message text test
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Checks where the text of a message lives. Flash text and borrowed text
+ * are placed in a simulated flash region, a page that is made read only, so
+ * the messages may only read it. Creating a playlist of 200 canned messages
+ * from it must allocate the message objects and not a single byte of text.
+ * A const char* is copied, so changing the text afterwards, like a char
+ * array on the stack that is reused, does not change the message.
+ */
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "AsyncScrollingChain.hpp"
+#include "check.h"
+
+TEXT_ANIMATION_DEFINE(anim, 60)
+
+static const size_t CANNED = 200;
+static const size_t TEXT_SIZE = 48;
+
+// a page of memory filled with text and then made read only, like flash
+class FlashRegion {
+public:
+
+  FlashRegion(size_t size)
+    : size(size) {
+    long page = sysconf(_SC_PAGESIZE);
+    this->size = (size + page - 1) / page * page;
+    memory = static_cast<char*>(mmap(nullptr, this->size,
+      PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  }
+
+  ~FlashRegion() {
+    munmap(memory, size);
+  }
+
+  char* get() {
+    return memory;
+  }
+
+  void protect() {
+    mprotect(memory, size, PROT_READ);
+  }
+
+private:
+
+  char* memory;
+  size_t size;
+};
+
+static size_t countMessages(AsyncScrollingMessage* first) {
+  size_t count = 0;
+  for (AsyncScrollingMessage* m = first; m != nullptr; m = m->getNext()) {
+    count++;
+  }
+  return count;
+}
+
+// true if both lists of messages show the same text in the same parts
+static bool sameText(AsyncScrollingMessage* a, AsyncScrollingMessage* b) {
+  for (; a != nullptr && b != nullptr; a = a->getNext(), b = b->getNext()) {
+    if (a->getLength() != b->getLength()
+      || a->getColumnOffset() != b->getColumnOffset()) {
+      return false;
+    }
+    for (size_t i = 0; i < a->getLength(); i++) {
+      if (a->getChar(i) != b->getChar(i)) {
+        return false;
+      }
+    }
+  }
+  return a == nullptr && b == nullptr;
+}
+
+// 200 canned messages from flash, or borrowed from RAM, cost only the
+// message objects
+template <typename MakeText>
+static void testCanned(
+  ArduinoLEDMatrix& matrix, const char* region, MakeText makeText) {
+  unsigned long allocations = HostHeap::getAllocations();
+  unsigned long long requested = HostHeap::getRequestedBytes();
+
+  AsyncScrollingChain playlist;
+  for (size_t i = 0; i < CANNED; i++) {
+    playlist.append(AsyncScrollingChain(AsyncScrollingMessage::generateMessages(
+      makeText(region + i * TEXT_SIZE), matrix, anim, Font_5x7)));
+  }
+
+  size_t messages = countMessages(playlist.getFirst());
+  CHECK(messages > CANNED);
+  CHECK_EQUAL(messages, HostHeap::getAllocations() - allocations);
+  CHECK_EQUAL(messages * sizeof(AsyncScrollingMessage),
+    HostHeap::getRequestedBytes() - requested);
+
+  // the messages read the text straight from the region
+  AsyncScrollingMessage* first = playlist.getFirst();
+  CHECK(strncmp(first->getMessage().c_str(), region, first->getLength()) == 0);
+}
+
+// a flash message draws the same frames as the same text in a String
+static const char flashText[] PROGMEM = "   in flash";
+
+static void testFlashFrames(ArduinoLEDMatrix& matrix) {
+  static uint32_t expected[61][4];
+  AsyncScrollingMessage copy(String(FPSTR(flashText)), matrix, Font_4x6);
+  copy.showMessage();
+  memcpy(expected, anim, sizeof(anim));
+
+  AsyncScrollingMessage flash(FPSTR(flashText), matrix, Font_4x6);
+  flash.showMessage();
+  CHECK(memcmp(expected, anim, sizeof(anim)) == 0);
+  CHECK_EQUAL(copy.getFrameCount(), matrix.getSequenceLength());
+}
+
+// a const char* is copied, so the caller can reuse its buffer
+static void testCopied(ArduinoLEDMatrix& matrix) {
+  char buffer[80];
+  strcpy(buffer, "   on the stack");
+  unsigned long long requested = HostHeap::getRequestedBytes();
+  AsyncScrollingMessage message(buffer, matrix, Font_5x7);
+  CHECK(HostHeap::getRequestedBytes() - requested >= strlen(buffer) + 1);
+  memset(buffer, 'x', strlen(buffer));
+  CHECK(message.getMessage() == "   on the stack");
+
+  strcpy(buffer, "   a longer text on the stack that is split into parts");
+  String original(buffer);
+  AsyncScrollingChain chain(AsyncScrollingMessage::generateMessages(
+    buffer, matrix, anim, Font_5x7));
+  CHECK(countMessages(chain.getFirst()) > 1);
+  memset(buffer, 'x', strlen(buffer));
+  AsyncScrollingChain expected(AsyncScrollingMessage::generateMessages(
+    original, matrix, anim, Font_5x7));
+  CHECK(sameText(expected.getFirst(), chain.getFirst()));
+
+  // a message that fits in one part takes over the temporary copy, so the
+  // text is only copied once
+  strcpy(buffer, "   short");
+  unsigned long allocations = HostHeap::getAllocations();
+  AsyncScrollingChain single(AsyncScrollingMessage::generateMessages(
+    buffer, matrix, anim, Font_5x7));
+  CHECK_EQUAL(2, HostHeap::getAllocations() - allocations);
+}
+
+int main() {
+  ArduinoLEDMatrix matrix;
+  matrix.textScrollSpeed(60);
+
+  FlashRegion region(CANNED * TEXT_SIZE);
+  for (size_t i = 0; i < CANNED; i++) {
+    snprintf(region.get() + i * TEXT_SIZE, TEXT_SIZE,
+      "   canned message number %zu, long enough", i);
+  }
+  region.protect();
+
+  testCanned(matrix, region.get(), [](const char* text) {
+    return F(text);
+  });
+  testCanned(matrix, region.get(), [](const char* text) {
+    return AsyncScrollingMessage::borrow(text);
+  });
+  testFlashFrames(matrix);
+  testCopied(matrix);
+  return checkResult("test_text");
+}
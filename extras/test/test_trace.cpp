@@ -0,0 +1,85 @@
+/**
+ * Trace test
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Plays a chain from generateMessages, part after part from the matrix
+ * callback, with tracing turned on, and records COMPLETE from the callback
+ * like the README shows. The trace is dumped to a file, which make check
+ * then decodes with extras/trace/decode_trace.py and checks with
+ * check_trace.py: every part is drawn, played and completed, in that order.
+ *
+ *   make build/test_trace && ./build/test_trace [dump file]
+ */
+
+#define ASYNC_SCROLLING_MESSAGE_TRACE 256
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+
+#include <stdio.h>
+
+#include "AsyncScrollingChain.hpp"
+#include "check.h"
+
+TEXT_ANIMATION_DEFINE(anim, 40)
+
+static volatile bool done = false;
+
+static void matrixCallback() {
+  ASYNC_SCROLLING_TRACE(COMPLETE, 0);
+  done = true;
+}
+
+// writes what AsyncScrollingTrace::dump prints to a file
+class FilePrint : public Print {
+public:
+
+  explicit FilePrint(FILE* file)
+    : file(file) {
+  }
+
+  size_t write(uint8_t c) override {
+    return fputc(c, file) == EOF ? 0 : 1;
+  }
+
+private:
+
+  FILE* file;
+};
+
+int main(int argc, char** argv) {
+  const char* path = argc > 1 ? argv[1] : "build/trace.txt";
+  ArduinoLEDMatrix matrix;
+  matrix.textScrollSpeed(50);
+  matrix.setCallback(matrixCallback);
+  AsyncScrollingChain chain(AsyncScrollingMessage::generateMessages(
+    "   a message long enough to be played in a few parts", matrix, anim,
+    Font_5x7));
+  size_t parts = 0;
+  for (AsyncScrollingMessage* m = chain.getFirst(); m != nullptr;
+    m = m->getNext()) {
+    parts++;
+  }
+  CHECK(parts >= 3);
+
+  AsyncScrollingTrace::reset();
+  for (AsyncScrollingMessage* m = chain.getFirst(); m != nullptr;
+    m = m->getNext()) {
+    done = false;
+    m->showMessage(anim);
+    while (!done) {
+      HostEmulator::advance(1);
+    }
+  }
+
+  FILE* file = fopen(path, "w");
+  CHECK(file != nullptr);
+  if (file != nullptr) {
+    FilePrint out(file);
+    out.print("parts,");
+    out.println((unsigned long)parts);
+    AsyncScrollingTrace::dump(out);
+    fclose(file);
+  }
+  return checkResult("test_trace");
+}
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+"""
+AsyncScrollingMessage trace decoder
+Copyright (c) 2025 Daniel Savaria
+
+Turns the output of AsyncScrollingTrace::dump into a readable timeline, and
+optionally into a Chrome trace file that can be opened in chrome://tracing
+or https://ui.perfetto.dev
+
+Usage:
+  decode_trace.py serial_log.txt
+  decode_trace.py serial_log.txt --chrome trace.json
+  cat serial_log.txt | decode_trace.py -
+"""
+
+import argparse
+import json
+import sys
+
+EVENT_NAMES = {
+    1: "render start",
+    2: "render end",
+    3: "play",
+    4: "complete",
+    5: "frame",
+    6: "user",
+}
+
+RENDER_START = 1
+RENDER_END = 2
+PLAY = 3
+COMPLETE = 4
+
+
+def read_events(lines):
+    """Return the events of the last dump in lines as (time, event, arg),
+    with the microsecond clock unwrapped so it keeps counting up."""
+    events = []
+    for line in lines:
+        line = line.strip()
+        if line.startswith("ast-begin,"):
+            events = []
+        elif line.startswith("ast,"):
+            try:
+                _, time, event, arg = line.split(",")
+                events.append((int(time), int(event), int(arg)))
+            except ValueError:
+                continue
+
+    # an event claims its place in the trace before it reads the clock, so
+    # one recorded from an interrupt in between can be a little earlier than
+    # the event before it. only a jump back of more than half the clock is
+    # the clock wrapping around
+    unwrapped = []
+    offset = 0
+    previous = None
+    for time, event, arg in events:
+        if previous is not None and previous - time > 1 << 31:
+            offset += 1 << 32
+        elif previous is not None and time - previous > 1 << 31:
+            offset -= 1 << 32
+        previous = time
+        unwrapped.append((time + offset, event, arg))
+    return unwrapped
+
+
+def print_timeline(events, out):
+    if not events:
+        out.write("no trace events found\n")
+        return
+    start = events[0][0]
+    last = start
+    render_start = None
+    play_start = None
+    for time, event, arg in events:
+        name = EVENT_NAMES.get(event, "event %d" % event)
+        note = ""
+        if event == RENDER_START:
+            render_start = time
+        elif event == RENDER_END and render_start is not None:
+            note = "  (rendered in %d us)" % (time - render_start)
+            render_start = None
+        elif event == PLAY:
+            play_start = time
+        elif event == COMPLETE and play_start is not None:
+            note = "  (played for %.1f ms)" % ((time - play_start) / 1000.0)
+            play_start = None
+        out.write("%12.3f ms  +%9d us  %-12s %6d%s\n" % (
+            (time - start) / 1000.0, time - last, name, arg, note))
+        last = time
+
+
+def chrome_trace(events):
+    """Render and play spans become complete events, everything else is an
+    instant event."""
+    trace = []
+    render_start = None
+    play_start = None
+    for time, event, arg in events:
+        if event == RENDER_START:
+            render_start = (time, arg)
+        elif event == RENDER_END and render_start is not None:
+            trace.append({
+                "name": "render", "ph": "X", "pid": 1, "tid": 1,
+                "ts": render_start[0], "dur": time - render_start[0],
+                "args": {"length": arg},
+            })
+            render_start = None
+        elif event == PLAY:
+            play_start = (time, arg)
+        elif event == COMPLETE and play_start is not None:
+            trace.append({
+                "name": "still" if play_start[1] else "scroll",
+                "ph": "X", "pid": 1, "tid": 2,
+                "ts": play_start[0], "dur": time - play_start[0],
+            })
+            play_start = None
+        else:
+            trace.append({
+                "name": EVENT_NAMES.get(event, "event %d" % event),
+                "ph": "i", "s": "t", "pid": 1, "tid": 3,
+                "ts": time, "args": {"arg": arg},
+            })
+    return {"traceEvents": trace, "displayTimeUnit": "ms"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("log", help="serial output with a trace dump, - for stdin")
+    parser.add_argument("--chrome", metavar="FILE",
+        help="also write a Chrome trace JSON file")
+    args = parser.parse_args()
+
+    if args.log == "-":
+        lines = sys.stdin.readlines()
+    else:
+        with open(args.log) as log:
+            lines = log.readlines()
+
+    events = read_events(lines)
+    print_timeline(events, sys.stdout)
+
+    if args.chrome:
+        with open(args.chrome, "w") as out:
+            json.dump(chrome_trace(events), out, indent=1)
+
+
+if __name__ == "__main__":
+    main()
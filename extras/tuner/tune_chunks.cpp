@@ -0,0 +1,257 @@
+/**
+ * AsyncScrollingMessage animation buffer tuner
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Helps pick MAX_CHARS for TEXT_ANIMATION_DEFINE. A bigger buffer costs RAM
+ * for as long as the sketch runs, a smaller one splits long messages into
+ * more continuations. This plans every message of a corpus with the same
+ * rules generateMessages uses, for a range of buffer sizes, and prints what
+ * each size costs.
+ *
+ * The corpus is a text file with one message per line. A line can start with
+ * the font it uses, "4x6:" or "5x7:", otherwise --font is used.
+ *
+ * Build and run on a computer:
+ *   g++ -std=c++11 -O2 -o tune_chunks tune_chunks.cpp
+ *   ./tune_chunks messages.txt --ram 2048
+ *
+ * Options:
+ *   --font 4x6|5x7   font of lines without a font, default 5x7
+ *   --min N          smallest MAX_CHARS to try, default 12
+ *   --max N          largest MAX_CHARS to try, default 200
+ *   --step N         step between sizes, default 4
+ *   --ram BYTES      the most RAM the animation buffer may use
+ *   --batch N        also count the plays when AsyncScrollingPlayer batches
+ *                    short messages with N blank columns between them
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "../../AsyncScrollingPlan.hpp"
+
+// the reserved header frame of TEXT_ANIMATION_DEFINE, the same as
+// ASYNC_SCROLLING_MESSAGE_RESERVED_FRAMES
+static const size_t RESERVED_FRAMES = 1;
+static const size_t BYTES_PER_FRAME = 4 * sizeof(uint32_t);
+static const size_t SCREEN_WIDTH = 12;
+
+struct Message {
+  size_t length;
+  size_t fontWidth;
+};
+
+struct Result {
+  size_t maxChars;
+  size_t ram;
+  size_t chunks;
+  size_t handoffs;
+  size_t overlapChars;
+  size_t longestChunks;
+  size_t batchedPlays;
+};
+
+static bool parseFont(const char* name, size_t& width) {
+  if (strcmp(name, "4x6") == 0) {
+    width = 4;
+    return true;
+  }
+  if (strcmp(name, "5x7") == 0) {
+    width = 5;
+    return true;
+  }
+  return false;
+}
+
+static bool readCorpus(
+  const char* path, size_t defaultWidth, std::vector<Message>& messages) {
+  FILE* file = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+  if (file == nullptr) {
+    fprintf(stderr, "can't open %s\n", path);
+    return false;
+  }
+
+  std::string line;
+  int c;
+  do {
+    c = fgetc(file);
+    if (c != EOF && c != '\n') {
+      if (c != '\r') {
+        line += (char)c;
+      }
+      continue;
+    }
+
+    Message message = { line.size(), defaultWidth };
+    if (line.size() >= 4 && line[3] == ':'
+      && parseFont(line.substr(0, 3).c_str(), message.fontWidth)) {
+      message.length -= 4;
+    }
+    if (message.length > 0) {
+      messages.push_back(message);
+    }
+    line.clear();
+  } while (c != EOF);
+
+  if (file != stdin) {
+    fclose(file);
+  }
+  return true;
+}
+
+// the same rule AsyncScrollingPlayer uses to batch consecutive messages: a
+// message that scrolls without continuations joins the batch before it while
+// the batch still fits in the buffer
+static size_t countBatchedPlays(
+  const std::vector<Message>& messages, size_t maxChars, size_t separator) {
+  size_t plays = 0;
+  size_t batchWidth = 0;
+  for (size_t m = 0; m < messages.size(); m++) {
+    size_t width = messages[m].length * messages[m].fontWidth;
+    if (width <= SCREEN_WIDTH || width > maxChars) {
+      AsyncScrollingPlan plan(
+        messages[m].length, messages[m].fontWidth, SCREEN_WIDTH, maxChars);
+      plays += plan.getChunkCount();
+      batchWidth = 0;
+    } else if (batchWidth != 0 && batchWidth + separator + width <= maxChars) {
+      batchWidth += separator + width;
+    } else {
+      plays++;
+      batchWidth = width;
+    }
+  }
+  return plays;
+}
+
+static Result evaluate(
+  const std::vector<Message>& messages, size_t maxChars, size_t separator) {
+  Result result = { maxChars, (maxChars + RESERVED_FRAMES) * BYTES_PER_FRAME,
+    0, 0, 0, 0, countBatchedPlays(messages, maxChars, separator) };
+  for (size_t m = 0; m < messages.size(); m++) {
+    AsyncScrollingPlan plan(
+      messages[m].length, messages[m].fontWidth, SCREEN_WIDTH, maxChars);
+    size_t count = plan.getChunkCount();
+    size_t drawn = 0;
+    for (size_t i = 0; i < count; i++) {
+      AsyncScrollingPlan::Chunk chunk = plan.getChunk(i);
+      drawn += chunk.end - chunk.start;
+    }
+    result.chunks += count;
+    result.handoffs += count - 1;
+    result.overlapChars += drawn - messages[m].length;
+    if (count > result.longestChunks) {
+      result.longestChunks = count;
+    }
+  }
+  return result;
+}
+
+static bool parseSize(const char* text, size_t& value) {
+  char* end;
+  unsigned long parsed = strtoul(text, &end, 10);
+  if (*text == '\0' || *end != '\0') {
+    return false;
+  }
+  value = parsed;
+  return true;
+}
+
+int main(int argc, char** argv) {
+  const char* path = nullptr;
+  size_t fontWidth = 5;
+  size_t minChars = 12;
+  size_t maxChars = 200;
+  size_t step = 4;
+  size_t ramBudget = 0;
+  size_t separator = 0;
+  bool batch = false;
+
+  for (int i = 1; i < argc; i++) {
+    bool ok = true;
+    if (strcmp(argv[i], "--font") == 0 && i + 1 < argc) {
+      ok = parseFont(argv[++i], fontWidth);
+    } else if (strcmp(argv[i], "--min") == 0 && i + 1 < argc) {
+      ok = parseSize(argv[++i], minChars);
+    } else if (strcmp(argv[i], "--max") == 0 && i + 1 < argc) {
+      ok = parseSize(argv[++i], maxChars);
+    } else if (strcmp(argv[i], "--step") == 0 && i + 1 < argc) {
+      ok = parseSize(argv[++i], step);
+    } else if (strcmp(argv[i], "--ram") == 0 && i + 1 < argc) {
+      ok = parseSize(argv[++i], ramBudget);
+    } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+      ok = parseSize(argv[++i], separator);
+      batch = true;
+    } else if (path == nullptr && (argv[i][0] != '-' || argv[i][1] == '\0')) {
+      path = argv[i];
+    } else {
+      ok = false;
+    }
+    if (!ok) {
+      fprintf(stderr, "bad argument %s\n", argv[i]);
+      return 2;
+    }
+  }
+
+  if (path == nullptr || minChars == 0 || step == 0 || maxChars < minChars) {
+    fprintf(stderr,
+      "usage: tune_chunks messages.txt [--font 4x6|5x7] [--min N] [--max N]"
+      " [--step N] [--ram BYTES] [--batch N]\n");
+    return 2;
+  }
+
+  std::vector<Message> messages;
+  if (!readCorpus(path, fontWidth, messages)) {
+    return 1;
+  }
+  if (messages.empty()) {
+    fprintf(stderr, "no messages in %s\n", path);
+    return 1;
+  }
+
+  printf("%zu messages\n\n", messages.size());
+  printf("%9s %7s %7s %9s %9s %13s",
+    "MAX_CHARS", "RAM", "chunks", "handoffs", "overlap", "most chunks");
+  printf(batch ? " %14s\n" : "\n", "batched plays");
+
+  std::vector<Result> results;
+  for (size_t size = minChars; size <= maxChars; size += step) {
+    Result result = evaluate(messages, size, separator);
+    if (ramBudget != 0 && result.ram > ramBudget) {
+      break;
+    }
+    results.push_back(result);
+    printf("%9zu %7zu %7zu %9zu %9zu %13zu", result.maxChars, result.ram,
+      result.chunks, result.handoffs, result.overlapChars,
+      result.longestChunks);
+    if (batch) {
+      printf(" %14zu", result.batchedPlays);
+    }
+    printf("\n");
+  }
+
+  if (results.empty()) {
+    printf("\nno size fits in %zu bytes\n", ramBudget);
+    return 1;
+  }
+
+  // more RAM only helps while it removes handoffs, so recommend the smallest
+  // size that has as few handoffs as the largest size that was tried
+  size_t fewest = results.back().handoffs;
+  const Result* best = &results.back();
+  for (size_t i = 0; i < results.size(); i++) {
+    if (results[i].handoffs == fewest) {
+      best = &results[i];
+      break;
+    }
+  }
+
+  printf("\nrecommended: MAX_CHARS %zu, %zu bytes, %zu handoffs,"
+    " %zu characters drawn twice\n",
+    best->maxChars, best->ram, best->handoffs, best->overlapChars);
+  return 0;
+}
@@ -0,0 +1,193 @@
+/**
+ * AsyncScrollingMessage chunk verifier
+ * Copyright (c) 2025 Daniel Savaria
+ *
+ * Checks that a message split into continuations looks exactly the same as
+ * the message scrolled in one piece. Every message is drawn twice with
+ * AsyncScrollingRender: once as a single scroll of the whole text, and once
+ * chunk by chunk as planned by AsyncScrollingPlan, with each chunk drawing
+ * only its own part of the text the way the board does. The board scrolls
+ * the part until its last column has left the screen and keeps only as many
+ * frames as the buffer holds, so that is what a chunk plays, and it has to
+ * be the number of frames the plan gave the chunk. The two streams of
+ * frames are compared and the first frame that is different is reported.
+ *
+ * Random texts, fonts and buffer sizes are tried, so changes to the planner
+ * can be checked before they reach a board. The fonts are made up, with
+ * random glyphs, so the check does not need ArduinoGraphics.
+ *
+ * Build and run on a computer:
+ *   g++ -std=c++11 -O2 -o verify_chunks verify_chunks.cpp
+ *   ./verify_chunks --cases 10000 --seed 1
+ *
+ * The exit status is 0 if every message matched and 1 otherwise.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../../AsyncScrollingPlan.hpp"
+#include "../../AsyncScrollingRender.hpp"
+
+typedef AsyncScrollingRender Render;
+
+// the same shape as the ArduinoGraphics Font struct
+struct TestFont {
+  int width;
+  int height;
+  const uint8_t* data[256];
+};
+
+struct Glyphs {
+  TestFont font;
+  std::vector<uint8_t> rows;
+};
+
+static void makeFont(Glyphs& glyphs, int width, std::mt19937& random) {
+  glyphs.font.width = width;
+  glyphs.font.height = 7;
+  glyphs.rows.assign(256 * glyphs.font.height, 0);
+  for (size_t c = 0; c < 256; c++) {
+    uint8_t* glyph = &glyphs.rows[c * glyphs.font.height];
+    // every glyph has its own pattern, so a column from the wrong character
+    // or the wrong place is never mistaken for the right one
+    for (int row = 0; row < glyphs.font.height; row++) {
+      glyph[row] = random() & (0xFF << (8 - width));
+    }
+    glyphs.font.data[c] = glyph;
+  }
+}
+
+struct Failure {
+  size_t frame;
+  size_t chunk;
+  // true if the chunk plays a different number of frames than planned
+  bool count;
+};
+
+// returns true if the chunked frames match the single scroll
+static bool compare(const std::string& text, const TestFont& font,
+  size_t frameCapacity, Failure& failure) {
+  AsyncScrollingPlan plan(
+    text.size(), font.width, Render::SCREEN_WIDTH, frameCapacity);
+
+  size_t frame = 0;
+  for (size_t c = 0; c < plan.getChunkCount(); c++) {
+    AsyncScrollingPlan::Chunk chunk = plan.getChunk(c);
+    const char* part = text.c_str() + chunk.start;
+    size_t partLength = chunk.end - chunk.start;
+
+    // the frames the board captures: one for every column the part moves,
+    // starting at the offset, cut off where the buffer is full
+    size_t scrolled = partLength * font.width > chunk.offset
+      ? partLength * font.width - chunk.offset
+      : 0;
+    size_t played = scrolled < frameCapacity ? scrolled : frameCapacity;
+    if (played != chunk.frames) {
+      failure.frame = frame;
+      failure.chunk = c;
+      failure.count = true;
+      return false;
+    }
+
+    for (size_t f = 0; f < played; f++, frame++) {
+      uint32_t ideal[3];
+      Render::clear(ideal);
+      Render::drawText(ideal, -(int)frame, font, text.size(),
+        [&text](size_t i) { return text[i]; });
+
+      uint32_t chunked[3];
+      Render::clear(chunked);
+      Render::drawText(chunked, -(int)(chunk.offset + f), font, partLength,
+        [part](size_t i) { return part[i]; });
+
+      if (memcmp(ideal, chunked, sizeof(ideal)) != 0) {
+        failure.frame = frame;
+        failure.chunk = c;
+        failure.count = false;
+        return false;
+      }
+    }
+  }
+
+  // the chunks together have to play every frame of the single scroll
+  if (frame != plan.getTotalFrames()) {
+    failure.frame = frame;
+    failure.chunk = plan.getChunkCount();
+    failure.count = true;
+    return false;
+  }
+  return true;
+}
+
+static bool parseSize(const char* text, unsigned long& value) {
+  char* end;
+  value = strtoul(text, &end, 10);
+  return *text != '\0' && *end == '\0';
+}
+
+int main(int argc, char** argv) {
+  unsigned long cases = 1000;
+  unsigned long seed = 1;
+  unsigned long maxLength = 200;
+
+  for (int i = 1; i < argc; i++) {
+    bool ok = false;
+    if (strcmp(argv[i], "--cases") == 0 && i + 1 < argc) {
+      ok = parseSize(argv[++i], cases);
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      ok = parseSize(argv[++i], seed);
+    } else if (strcmp(argv[i], "--length") == 0 && i + 1 < argc) {
+      ok = parseSize(argv[++i], maxLength) && maxLength > 0;
+    }
+    if (!ok) {
+      fprintf(stderr,
+        "usage: verify_chunks [--cases N] [--seed N] [--length N]\n");
+      return 2;
+    }
+  }
+
+  std::mt19937 random(seed);
+  Glyphs glyphs[9];
+  for (int width = 1; width <= 8; width++) {
+    makeFont(glyphs[width], width, random);
+  }
+
+  unsigned long failures = 0;
+  unsigned long frames = 0;
+  for (unsigned long n = 0; n < cases; n++) {
+    const TestFont& font = glyphs[1 + random() % 8].font;
+    size_t length = 1 + random() % maxLength;
+    // messages that fit on the screen are shown still and never split
+    if (length * font.width <= Render::SCREEN_WIDTH) {
+      continue;
+    }
+    size_t frameCapacity = 1 + random() % (length * font.width + 20);
+
+    std::string text;
+    for (size_t i = 0; i < length; i++) {
+      text += (char)(' ' + random() % 95);
+    }
+
+    Failure failure;
+    if (!compare(text, font, frameCapacity, failure)) {
+      if (failures < 10) {
+        printf("case %lu: %zu characters, font width %d, %zu frames per"
+          " chunk: %s %zu in chunk %zu\n", n, length, font.width,
+          frameCapacity, failure.count ? "wrong frame count at frame"
+          : "different frame", failure.frame, failure.chunk);
+      }
+      failures++;
+    }
+    frames += length * font.width;
+  }
+
+  printf("%lu cases, %lu frames, %lu different\n", cases, frames, failures);
+  return failures == 0 ? 0 : 1;
+}